@@ -25,6 +25,17 @@ pluss(double a, double b)
     return a + b;
 }
 
+// batch kernel for pluss, a plain loop over the columns that the compiler can
+// vectorize
+void
+pluss_kernel(double* results, const double* a, const double* b, std::size_t n)
+{
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        results[i] = a[i] + b[i];
+    }
+}
+
 namespace refl
 {
 typedef std::vector<double> vector_double;
@@ -35,7 +46,7 @@ REGISTER_TYPE(vector_double_iterator)
 REGISTER_TYPE_END()
 
 REGISTER_FREE_FUNCTION(average<vector_double_iterator>)
-REGISTER_FREE_FUNCTION(pluss)
+REGISTER_FREE_FUNCTION_WITH_BATCH_KERNEL(pluss, pluss_kernel)
 
 REGISTER_MEMBER_FUNCTION_EXPLICIT(vector_double, begin, vector_double_iterator)
 REGISTER_MEMBER_FUNCTION_EXPLICIT(vector_double, end, vector_double_iterator)
@@ -203,9 +214,9 @@ test2()
                    data2_refl.begin(),
                    std::back_inserter(result_refl),
                    [&pluss_tag](const auto& obj_a, const auto& obj_b) {
-                       std::vector<shadow::object> args{obj_a, obj_b};
+                       shadow::object args[] = {obj_a, obj_b};
                        return refl::manager.call_free_function(
-                           pluss_tag, args.begin(), args.end());
+                           pluss_tag, std::begin(args), std::end(args));
                    });
     const auto end_refl = std::chrono::system_clock::now();
     const auto dur_refl = end_refl - start_refl;
@@ -213,6 +224,46 @@ test2()
                              std::chrono::system_clock::duration::period::den;
 
     std::cout << "call reflectively: " << secs_refl << "s\n";
+
+
+    // typed calls on the native data, signature checked once
+    const auto pluss_typed =
+        refl::manager.free_function_handle<double(double, double)>(pluss_tag);
+
+    std::vector<double> result_typed;
+    result_typed.reserve(num_samples);
+
+    const auto start_typed = std::chrono::system_clock::now();
+    std::transform(data1_native.begin(),
+                   data1_native.end(),
+                   data2_native.begin(),
+                   std::back_inserter(result_typed),
+                   [&pluss_typed](const double a, const double b) {
+                       return pluss_typed(a, b);
+                   });
+    const auto end_typed = std::chrono::system_clock::now();
+    const auto dur_typed = end_typed - start_typed;
+    const double secs_typed = static_cast<double>(dur_typed.count()) /
+                              std::chrono::system_clock::duration::period::den;
+
+    std::cout << "call through typed handle: " << secs_typed << "s\n";
+
+
+    // one batch call over the native data, running the registered kernel
+    std::vector<double> result_batch(num_samples);
+
+    const auto start_batch = std::chrono::system_clock::now();
+    refl::manager.invoke_batch(pluss_tag,
+                               num_samples,
+                               result_batch.data(),
+                               data1_native.data(),
+                               data2_native.data());
+    const auto end_batch = std::chrono::system_clock::now();
+    const auto dur_batch = end_batch - start_batch;
+    const double secs_batch = static_cast<double>(dur_batch.count()) /
+                              std::chrono::system_clock::duration::period::den;
+
+    std::cout << "call as batch: " << secs_batch << "s\n";
 }
 
 int
@@ -0,0 +1,145 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cassert>
+
+#include <shadow.hpp>
+
+
+// compares reading and writing a member variable of many reflected objects
+// through the get/set bind points with the offset based member_accessor
+
+struct particle
+{
+    double x;
+    double y;
+    double mass;
+    int id;
+};
+
+namespace refl
+{
+REGISTER_TYPE_BEGIN()
+REGISTER_TYPE(particle)
+REGISTER_TYPE_END()
+
+REGISTER_MEMBER_VARIABLE(particle, x)
+REGISTER_MEMBER_VARIABLE(particle, y)
+REGISTER_MEMBER_VARIABLE(particle, mass)
+REGISTER_MEMBER_VARIABLE(particle, id)
+
+SHADOW_INIT()
+}
+
+
+constexpr auto num_objects = 1000000ul;
+
+
+template <class F>
+double
+seconds_taken(F&& f)
+{
+    const auto start = std::chrono::system_clock::now();
+    f();
+    const auto end = std::chrono::system_clock::now();
+    const auto dur = end - start;
+    return static_cast<double>(dur.count()) /
+           std::chrono::system_clock::duration::period::den;
+}
+
+
+void
+report(const char* name, double read_secs, double write_secs, double sum)
+{
+    std::cout << std::setw(16) << name << std::setw(14) << read_secs
+              << std::setw(14) << write_secs << "    sum = " << sum << '\n';
+}
+
+
+int
+main()
+{
+    std::vector<shadow::object> objects;
+    objects.reserve(num_objects);
+    for(auto i = 0ul; i < num_objects; ++i)
+    {
+        objects.push_back(refl::static_make_object(
+            particle{double(i), 2.0 * i, 1.0, static_cast<int>(i)}));
+    }
+
+    const auto mass_mv = *refl::manager.find_member_variable(
+        objects.front().type(), shadow::string_view("mass"));
+
+    std::cout << std::setw(16) << "path" << std::setw(14) << "read (s)"
+              << std::setw(14) << "write (s)" << '\n';
+
+    // get_member_variable/set_member_variable through the bind points
+    {
+        double sum = 0.0;
+        const auto read = seconds_taken([&]() {
+            for(const auto& obj : objects)
+            {
+                sum += refl::manager.get<double>(
+                    refl::manager.get_member_variable(obj, mass_mv));
+            }
+        });
+
+        const auto value = refl::static_make_object(2.0);
+        const auto write = seconds_taken([&]() {
+            for(auto& obj : objects)
+            {
+                refl::manager.set_member_variable(obj, mass_mv, value);
+            }
+        });
+
+        report("bind point", read, write, sum);
+    }
+
+    // member_variable_reference, checked per object
+    {
+        double sum = 0.0;
+        const auto read = seconds_taken([&]() {
+            for(const auto& obj : objects)
+            {
+                sum += refl::manager.member_variable_reference(obj, mass_mv)
+                           .get<double>();
+            }
+        });
+
+        const auto write = seconds_taken([&]() {
+            for(auto& obj : objects)
+            {
+                refl::manager.member_variable_reference(obj, mass_mv)
+                    .get<double>() = 3.0;
+            }
+        });
+
+        report("reference", read, write, sum);
+    }
+
+    // member_accessor, checked once
+    {
+        const auto mass =
+            refl::manager.member_variable_accessor<double>(mass_mv);
+
+        double sum = 0.0;
+        const auto read = seconds_taken([&]() {
+            for(const auto& obj : objects)
+            {
+                sum += mass.get(obj);
+            }
+        });
+
+        const auto write = seconds_taken([&]() {
+            for(auto& obj : objects)
+            {
+                mass.set(obj, 4.0);
+            }
+        });
+
+        report("offset", read, write, sum);
+    }
+
+    assert(refl::manager.get<particle>(objects.back()).mass == 4.0);
+}
@@ -0,0 +1,112 @@
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+
+#include <any.hpp>
+
+
+// reports, for each registered fundamental type, whether a shadow::any holding
+// it allocates and how long copying such an any takes
+
+struct point
+{
+    double x;
+    double y;
+    double z;
+};
+
+
+constexpr auto num_copies = 1000000ul;
+
+// the small buffer used to be the size of a pointer, with the value only
+// going inline if it was strictly smaller than that
+// the old buffer is no longer built, so the "before" column is predicted from
+// this rule rather than measured
+template <class T>
+constexpr bool old_small_buffer_rule = sizeof(T) < sizeof(void*);
+
+
+struct heap_hits
+{
+    unsigned int types = 0;
+    // predicted by old_small_buffer_rule
+    unsigned int before = 0;
+    unsigned int after = 0;
+};
+
+
+template <class T>
+void
+report(const char* name, heap_hits& hits)
+{
+    const shadow::any original{T{}};
+
+    const auto start = std::chrono::system_clock::now();
+    for(auto i = 0ul; i < num_copies; ++i)
+    {
+        shadow::any copy(original);
+        asm volatile("" : : "g"(&copy) : "memory");
+    }
+    const auto end = std::chrono::system_clock::now();
+    const auto dur = end - start;
+    const double secs = static_cast<double>(dur.count()) /
+                        std::chrono::system_clock::duration::period::den;
+
+    const bool heap_before = !old_small_buffer_rule<T>;
+    const bool heap_after = original.on_heap();
+
+    ++hits.types;
+    hits.before += heap_before;
+    hits.after += heap_after;
+
+    std::cout << std::setw(24) << name << std::setw(8) << sizeof(T)
+              << std::setw(20) << (heap_before ? "heap" : "inline")
+              << std::setw(10) << (heap_after ? "heap" : "inline")
+              << std::setw(14) << secs << '\n';
+}
+
+
+int
+main()
+{
+    std::cout << "small buffer size: " << sizeof(shadow::any_buffer)
+              << " bytes, sizeof(shadow::any): " << sizeof(shadow::any)
+              << " bytes\n\n";
+
+    std::cout << std::setw(24) << "type" << std::setw(8) << "size"
+              << std::setw(20) << "before (predicted)" << std::setw(10) << "after"
+              << std::setw(14) << "copy time" << '\n';
+
+    heap_hits hits;
+
+    report<std::nullptr_t>("std::nullptr_t", hits);
+    report<bool>("bool", hits);
+    report<signed char>("signed char", hits);
+    report<unsigned char>("unsigned char", hits);
+    report<char>("char", hits);
+    report<wchar_t>("wchar_t", hits);
+    report<char16_t>("char16_t", hits);
+    report<char32_t>("char32_t", hits);
+    report<short int>("short int", hits);
+    report<unsigned short int>("unsigned short int", hits);
+    report<int>("int", hits);
+    report<unsigned int>("unsigned int", hits);
+    report<long int>("long int", hits);
+    report<unsigned long int>("unsigned long int", hits);
+    report<long long int>("long long int", hits);
+    report<unsigned long long int>("unsigned long long int", hits);
+    report<float>("float", hits);
+    report<double>("double", hits);
+    report<long double>("long double", hits);
+    report<std::string>("std::string", hits);
+
+    std::cout << "\nheap hit rate on fundamental types: predicted before "
+              << hits.before << '/' << hits.types << ", after " << hits.after
+              << '/' << hits.types << "\n\n";
+
+    heap_hits other_hits;
+    report<std::vector<double>>("std::vector<double>", other_hits);
+    report<point>("point", other_hits);
+}
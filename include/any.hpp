@@ -2,62 +2,123 @@
 #define ANY_HPP
 
 
+#include <cstddef>
+#include <new>
 #include <type_traits>
 #include <utility>
 
 
+// size in bytes of the small buffer inside shadow::any, values that fit within
+// it are stored inline instead of on the heap
+#ifndef SHADOW_ANY_BUFFER_SIZE
+#define SHADOW_ANY_BUFFER_SIZE 32
+#endif
+
+
 namespace shadow
 {
-// abstract base class providing interface to held value
-class holder_base
+// storage for values held inline by any
+typedef std::aligned_storage_t<SHADOW_ANY_BUFFER_SIZE,
+                               alignof(std::max_align_t)>
+    any_buffer;
+
+static_assert(sizeof(any_buffer) >= sizeof(void*),
+              "SHADOW_ANY_BUFFER_SIZE must be able to hold a pointer");
+
+
+// table of operations on a held value, one static instance exists for each
+// type held by any, so the address of the table also identifies the type
+struct any_operations
 {
-public:
-    virtual holder_base* copy() const = 0;
-    virtual void placement_copy(
-        std::aligned_storage_t<sizeof(holder_base*)>* buffer) const = 0;
-    virtual ~holder_base() = default;
+    // copy construct value at src into uninitialized storage at dst
+    void (*copy)(const void* src, void* dst);
+    // move construct value at src into uninitialized storage at dst and
+    // destroy the value at src
+    void (*move)(void* src, void* dst);
+    // copy value at src into a new heap allocation
+    void* (*clone)(const void* src);
+    // destroy value in place
+    void (*destroy)(void* value);
+    // destroy and deallocate heap allocated value
+    void (*deallocate)(void* value);
+    // true if move can't throw, otherwise containers relocating values copy
+    // them so the originals are left intact if a copy throws
+    bool nothrow_move;
 };
 
 
-// concrete subclass holding value of any type
 template <class T>
-class holder : public holder_base
+struct any_operations_for
 {
-    friend class any;
+    static void
+    copy(const void* src, void* dst)
+    {
+        new(dst) T(*static_cast<const T*>(src));
+    }
 
-public:
-    holder(const T& value) : value_(value)
+    static void
+    move(void* src, void* dst)
     {
+        T* src_value = static_cast<T*>(src);
+        new(dst) T(std::move(*src_value));
+        src_value->~T();
     }
 
-    holder(T&& value) : value_(std::move(value))
+    static void*
+    clone(const void* src)
     {
+        return new T(*static_cast<const T*>(src));
     }
 
-    virtual holder_base*
-    copy() const override
+    static void
+    destroy(void* value)
     {
-        return new holder<T>(value_);
+        static_cast<T*>(value)->~T();
     }
 
-    virtual void
-    placement_copy(
-        std::aligned_storage_t<sizeof(holder_base*)>* buffer) const override
+    static void
+    deallocate(void* value)
     {
-        new(buffer) holder<T>(value_);
+        delete static_cast<T*>(value);
     }
 
-private:
-    T value_;
+    static constexpr any_operations value = {
+        &copy,
+        &move,
+        &clone,
+        &destroy,
+        &deallocate,
+        std::is_nothrow_move_constructible<T>::value};
 };
 
+template <class T>
+constexpr any_operations any_operations_for<T>::value;
+
 
+// types whose objects can be moved to a new address by copying their bytes and
+// abandoning the original without calling its destructor
+// any moves such values with memcpy when held inline, specialize for your own
+// types where this holds
+template <class T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T>
+{
+};
+
+template <class T>
+constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+
+// a value is held inline if it fits in the small buffer with the right
+// alignment and can be moved without throwing, so that moving an any never
+// throws
 template <class T>
 struct is_small_buffer_type
 {
     static const bool value =
-        sizeof(std::decay_t<T>) <
-        sizeof(std::aligned_storage_t<sizeof(holder_base*)>);
+        sizeof(std::decay_t<T>) <= sizeof(any_buffer) &&
+        alignof(std::decay_t<T>) <= alignof(any_buffer) &&
+        (std::is_nothrow_move_constructible<std::decay_t<T>>::value ||
+         is_trivially_relocatable_v<std::decay_t<T>>);
 };
 
 template <class T>
@@ -76,9 +137,11 @@ public:
         class T,
         class = std::enable_if_t<is_small_buffer_type_v<T> &&
                                  !std::is_same<std::decay_t<T>, any>::value>>
-    any(T&& value) : on_heap_(false)
+    any(T&& value)
+        : operations_(&any_operations_for<std::decay_t<T>>::value),
+          storage_(inline_storage_for<std::decay_t<T>>())
     {
-        new(&stack) holder<std::decay_t<T>>(std::forward<T>(value));
+        new(&stack) std::decay_t<T>(std::forward<T>(value));
     }
 
     // construct any with contained object of type std::decay_t<T>
@@ -89,8 +152,9 @@ public:
                                  !std::is_same<std::decay_t<T>, any>::value>,
         class = void>
     any(T&& value)
-        : on_heap_(true),
-          heap(new holder<std::decay_t<T>>(std::forward<T>(value)))
+        : operations_(&any_operations_for<std::decay_t<T>>::value),
+          storage_(heap_storage),
+          heap(new std::decay_t<T>(std::forward<T>(value)))
     {
     }
 
@@ -98,23 +162,40 @@ public:
     any(const any& other);
 
     // move constructor
-    any(any&& other);
+    any(any&& other) noexcept;
 
     // copy assignment
     any& operator=(const any& other);
 
     // move assignment
-    any& operator=(any&& other);
+    any& operator=(any&& other) noexcept;
 
     // swap
-    void swap(any& other);
+    void swap(any& other) noexcept;
 
     ~any();
 
+    // any referring to value at address, held elsewhere with the given
+    // operations, without owning it
+    // the value is accessed in place, while copies of the any hold their own
+    // copies of the value
+    static any reference_to(void* value, const any_operations* operations);
+
 public:
     bool has_value() const;
     bool on_heap() const;
 
+    // true if the any refers to a value it doesn't own
+    bool is_reference() const;
+
+    // true if the held value is of type std::decay_t<T>
+    template <class T>
+    bool has_type() const;
+
+    // pointer to the held value, nullptr if empty
+    void* data();
+    const void* data() const;
+
     template <class T>
     std::decay_t<T>& get();
 
@@ -122,10 +203,46 @@ public:
     const std::decay_t<T>& get() const;
 
 private:
-    bool on_heap_;
+    // destroy held value, leaving the any empty
+    void reset();
+
+    // take over the value held by other, leaving other empty
+    // precondition: *this is empty
+    void steal(any& other) noexcept;
+
+private:
+    enum storage_type : unsigned char
+    {
+        // trivially copyable value in the small buffer, copied, moved and
+        // destroyed without going through operations_
+        trivial_storage,
+        // trivially relocatable value in the small buffer, moved by copying
+        // the buffer, copied and destroyed through operations_
+        relocatable_storage,
+        // value in the small buffer
+        inline_storage,
+        // value allocated on the heap, or empty if heap is nullptr
+        heap_storage,
+        // value owned by someone else at the address in heap
+        // values are held in the small buffer for all kinds before heap_storage
+        reference_storage
+    };
+
+    template <class T>
+    static constexpr storage_type
+    inline_storage_for()
+    {
+        return std::is_trivially_copyable<T>::value
+                   ? trivial_storage
+                   : is_trivially_relocatable_v<T> ? relocatable_storage
+                                                   : inline_storage;
+    }
+
+    const any_operations* operations_;
+    storage_type storage_;
     union {
-        holder_base* heap;
-        std::aligned_storage_t<sizeof heap> stack;
+        void* heap;
+        any_buffer stack;
     };
 };
 
@@ -135,43 +252,36 @@ static void swap(any& lhs, any& rhs);
 
 namespace shadow
 {
-inline any::any() : on_heap_(true), heap(nullptr)
+inline any::any() : operations_(nullptr), storage_(heap_storage), heap(nullptr)
 {
 }
 
-inline any::any(const any& other) : on_heap_(other.on_heap_)
+inline any::any(const any& other)
+    : operations_(other.operations_), storage_(other.storage_)
 {
-    if(other.on_heap_)
+    switch(storage_)
     {
-        if(other.heap == nullptr)
-        {
-            heap = nullptr;
-        }
-        else
-        {
-            heap = other.heap->copy();
-        }
-    }
-    else
-    {
-        reinterpret_cast<const holder_base*>(&other.stack)
-            ->placement_copy(&stack);
+    case trivial_storage:
+        stack = other.stack;
+        break;
+    case relocatable_storage:
+    case inline_storage:
+        operations_->copy(&other.stack, &stack);
+        break;
+    case heap_storage:
+        heap = other.heap == nullptr ? nullptr : operations_->clone(other.heap);
+        break;
+    case reference_storage:
+        storage_ = heap_storage;
+        heap = operations_->clone(other.heap);
+        break;
     }
 }
 
-inline any::any(any&& other) : on_heap_(other.on_heap_)
+inline any::any(any&& other) noexcept
+    : operations_(nullptr), storage_(heap_storage), heap(nullptr)
 {
-    if(other.on_heap_)
-    {
-        heap = other.heap;
-        other.heap = nullptr;
-    }
-    else
-    {
-        stack = other.stack;
-        other.on_heap_ = true;
-        other.heap = nullptr;
-    }
+    steal(other);
 }
 
 inline any&
@@ -184,102 +294,159 @@ any::operator=(const any& other)
 }
 
 inline any&
-any::operator=(any&& other)
+any::operator=(any&& other) noexcept
 {
-    shadow::any temp(std::move(other));
-    swap(temp);
+    if(this != &other)
+    {
+        reset();
+        steal(other);
+    }
 
     return *this;
 }
 
 inline void
-any::swap(any& other)
+any::swap(any& other) noexcept
 {
-    using std::swap;
-
-    if(on_heap_ == true && other.on_heap_ == true)
+    if(this == &other)
     {
-        swap(heap, other.heap);
         return;
     }
-    if(on_heap_ == true && other.on_heap_ == false)
-    {
-        // create heap copy
-        auto ptr_copy = heap;
-        stack = other.stack;
-        other.heap = ptr_copy;
 
-        swap(on_heap_, other.on_heap_);
-        return;
-    }
-    if(on_heap_ == false && other.on_heap_ == true)
-    {
-        // create heap copy
-        auto ptr_copy = other.heap;
-        other.stack = stack;
-        heap = ptr_copy;
-
-        swap(on_heap_, other.on_heap_);
-        return;
-    }
-    if(on_heap_ == false && other.on_heap_ == false)
-    {
-        swap(stack, other.stack);
-        return;
-    }
+    any temp(std::move(other));
+    other.steal(*this);
+    steal(temp);
 }
 
 inline any::~any()
 {
-    if(on_heap_)
+    reset();
+}
+
+inline any
+any::reference_to(void* value, const any_operations* operations)
+{
+    any out;
+    out.operations_ = operations;
+    out.storage_ = reference_storage;
+    out.heap = value;
+
+    return out;
+}
+
+inline void
+any::reset()
+{
+    switch(storage_)
     {
-        delete heap;
+    case trivial_storage:
+        break;
+    case relocatable_storage:
+    case inline_storage:
+        operations_->destroy(&stack);
+        break;
+    case heap_storage:
+        if(heap != nullptr)
+        {
+            operations_->deallocate(heap);
+        }
+        break;
+    case reference_storage:
+        break;
     }
-    else
+
+    operations_ = nullptr;
+    storage_ = heap_storage;
+    heap = nullptr;
+}
+
+inline void
+any::steal(any& other) noexcept
+{
+    operations_ = other.operations_;
+    storage_ = other.storage_;
+
+    switch(storage_)
     {
-        reinterpret_cast<holder_base*>(&stack)->~holder_base();
+    case trivial_storage:
+    case relocatable_storage:
+        stack = other.stack;
+        break;
+    case inline_storage:
+        operations_->move(&other.stack, &stack);
+        break;
+    case heap_storage:
+    case reference_storage:
+        heap = other.heap;
+        break;
     }
+
+    // the value has been moved out of other, so it's left empty without
+    // destroying anything
+    other.operations_ = nullptr;
+    other.storage_ = heap_storage;
+    other.heap = nullptr;
 }
 
 inline bool
 any::has_value() const
 {
-    if(on_heap_)
-    {
-        return heap != nullptr;
-    }
-
-    return true;
+    return operations_ != nullptr;
 }
 
 inline bool
 any::on_heap() const
 {
-    return on_heap_;
+    return storage_ == heap_storage;
+}
+
+inline bool
+any::is_reference() const
+{
+    return storage_ == reference_storage;
+}
+
+template <class T>
+inline bool
+any::has_type() const
+{
+    return operations_ == &any_operations_for<std::decay_t<T>>::value;
+}
+
+inline void*
+any::data()
+{
+    return storage_ >= heap_storage ? heap : static_cast<void*>(&stack);
+}
+
+inline const void*
+any::data() const
+{
+    return storage_ >= heap_storage ? heap : static_cast<const void*>(&stack);
 }
 
 template <class T>
 inline std::decay_t<T>&
 any::get()
 {
-    if(on_heap_)
+    if(storage_ >= heap_storage)
     {
-        return static_cast<holder<std::decay_t<T>>*>(heap)->value_;
+        return *static_cast<std::decay_t<T>*>(heap);
     }
 
-    return reinterpret_cast<holder<std::decay_t<T>>*>(&stack)->value_;
+    return *reinterpret_cast<std::decay_t<T>*>(&stack);
 }
 
 template <class T>
 inline const std::decay_t<T>&
 any::get() const
 {
-    if(on_heap_)
+    if(storage_ >= heap_storage)
     {
-        return static_cast<const holder<std::decay_t<T>>*>(heap)->value_;
+        return *static_cast<const std::decay_t<T>*>(heap);
     }
 
-    return reinterpret_cast<const holder<std::decay_t<T>>*>(&stack)->value_;
+    return *reinterpret_cast<const std::decay_t<T>*>(&stack);
 }
 
 inline void
@@ -6,6 +6,7 @@
 #include <cstring>
 #include <ostream>
 #include <istream>
+#include <utility>
 
 #include <any.hpp>
 #include <reflection_info.hpp>
@@ -28,6 +29,7 @@ class info_type_aggregate
     friend class comparison_policy;
 
     friend class reflection_manager;
+    friend class object_vector;
 
 public:
     info_type_aggregate() = default;
@@ -60,6 +62,13 @@ public:
     {
         return std::string(static_cast<const Derived*>(this)->info_ptr_->name);
     }
+
+    // name without allocating, valid for as long as the reflection information
+    string_view
+    name_view() const
+    {
+        return name_view_of(*static_cast<const Derived*>(this)->info_ptr_);
+    }
 };
 
 template <class Derived>
@@ -81,8 +90,15 @@ public:
     bool
     operator==(const Derived& other) const
     {
-        if(std::strcmp(static_cast<const Derived*>(this)->info_ptr_->name,
-                       other.info_ptr_->name) == 0)
+        const auto info_ptr = static_cast<const Derived*>(this)->info_ptr_;
+
+        // tags from the same reflection_manager share info
+        if(info_ptr == other.info_ptr_)
+        {
+            return true;
+        }
+
+        if(std::strcmp(info_ptr->name, other.info_ptr_->name) == 0)
         {
             return true;
         }
@@ -117,10 +133,29 @@ typedef info_type_aggregate<member_variable_info, name_policy>
 
 class reflection_manager;
 
+template <class T>
+class member_accessor;
+
+class object_vector;
+
+class bound_call;
+
+template <class Object>
+class basic_object_reference;
+
 class object
 {
     friend class reflection_manager;
 
+    template <class T>
+    friend class member_accessor;
+
+    friend class object_vector;
+    friend class bound_call;
+
+    template <class Object>
+    friend class basic_object_reference;
+
     friend std::ostream& operator<<(std::ostream&, const object&);
     friend std::istream& operator>>(std::istream& in, object& obj);
 
@@ -131,12 +166,83 @@ public:
 
     type_tag type() const;
 
+private:
+    // object referring to the value held by obj, without owning it
+    static object reference_to(const object& obj);
+
 private:
     any value_;
     const type_info* type_info_;
     const reflection_manager* manager_;
 
 private:
-    static constexpr const type_info void_info{"void", 0, nullptr, nullptr};
+    static constexpr const type_info void_info{"void",
+                                               0,
+                                               nullptr,
+                                               nullptr,
+                                               hash_name("void"),
+                                               4,
+                                               false,
+                                               nullptr,
+                                               false,
+                                               0,
+                                               nullptr};
+};
+
+
+// value held elsewhere, eg. by an object_vector or a bound_call, converting to
+// a reference to an object that refers to the value in place, eg.
+//     auto element = vec[0];
+//     manager.set_member_variable(element, tag, value);
+// modifies the value held by vec. Objects initialized from it hold their own
+// copies of the value, so they never refer to a removed or relocated value,
+// and const_object_reference only converts to const object&.
+// Copies of a reference refer to the same value.
+template <class Object>
+class basic_object_reference
+{
+    friend class object_vector;
+    friend class bound_call;
+
+public:
+    basic_object_reference(const basic_object_reference& other)
+        : value_(object::reference_to(other.value_))
+    {
+    }
+
+    basic_object_reference(basic_object_reference&& other) = default;
+
+    basic_object_reference&
+    operator=(const basic_object_reference& other)
+    {
+        value_ = object::reference_to(other.value_);
+        return *this;
+    }
+
+    basic_object_reference&
+    operator=(basic_object_reference&& other) = default;
+
+public:
+    type_tag
+    type() const
+    {
+        return value_.type();
+    }
+
+    operator Object&() const
+    {
+        return value_;
+    }
+
+private:
+    explicit basic_object_reference(object value) : value_(std::move(value))
+    {
+    }
+
+private:
+    mutable object value_;
 };
+
+typedef basic_object_reference<object> object_reference;
+typedef basic_object_reference<const object> const_object_reference;
 }
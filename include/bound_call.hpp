@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "any.hpp"
+#include "api_types.hpp"
+#include "exceptions.hpp"
+#include "reflection_info.hpp"
+
+
+namespace shadow
+{
+class reflection_manager;
+
+
+// call of a free or member function with its arguments held in preallocated
+// slots, made by reflection_manager::bind_call
+// the argument types are checked once when the call is bound, after which the
+// slots can be refilled and the function called any number of times, each
+// call going straight to the bind point of the function
+class bound_call
+{
+    friend class reflection_manager;
+
+public:
+    bound_call(const bound_call& other);
+    bound_call(bound_call&& other) = default;
+
+    bound_call& operator=(const bound_call& other);
+    bound_call& operator=(bound_call&& other) = default;
+
+public:
+    // number of argument slots
+    std::size_t
+    size() const
+    {
+        return arguments_.size();
+    }
+
+    // reference to the value in the slot at index, eg. to read back out
+    // parameters after a call. Calls don't invalidate it, but set_argument on
+    // the same slot may replace the value it refers to, as does assigning to
+    // or destroying the bound_call. Objects initialized from it hold their own
+    // copies of the value.
+    // throws argument_error if index is out of range
+    object_reference argument(std::size_t index);
+
+    // copy value held by val into the slot at index
+    // throws argument_error if index is out of range or val doesn't hold a
+    // value of the parameter type
+    void set_argument(std::size_t index, const object& val);
+
+    // unchecked access to the value in the slot at index, T must be the
+    // parameter type without references and pointers
+    template <class T>
+    T&
+    get(std::size_t index)
+    {
+        return value_of(index).get<T>();
+    }
+
+    // call bound free function, throws argument_error for member functions
+    object call();
+
+    // call bound member function on obj
+    // throws argument_error for free functions, and type_error if obj isn't of
+    // the class type of the member function
+    object call(object& obj);
+
+private:
+    template <class Iterator>
+    bound_call(const reflection_manager* manager,
+               free_function_binding_signature free_bind_point,
+               member_function_binding_signature member_bind_point,
+               const type_info* class_info,
+               const type_info* return_info,
+               const type_info* type_infos,
+               const std::size_t* parameter_type_indices,
+               const bool* pointer_flags,
+               Iterator first,
+               Iterator last);
+
+    any& value_of(std::size_t index);
+
+    // point slots of pointer parameters to their values
+    void bind_pointers();
+
+private:
+    const reflection_manager* manager_;
+    free_function_binding_signature free_bind_point_;
+    member_function_binding_signature member_bind_point_;
+    // nullptr for free functions
+    const type_info* class_info_;
+    const type_info* return_info_;
+    const bool* pointer_flags_;
+    std::vector<const type_info*> parameter_infos_;
+    // argument array passed to the bind point
+    std::vector<any> arguments_;
+    // values pointed to by the slots of pointer parameters, empty for others
+    std::vector<any> pointees_;
+};
+
+
+template <class Iterator>
+inline bound_call::bound_call(
+    const reflection_manager* manager,
+    free_function_binding_signature free_bind_point,
+    member_function_binding_signature member_bind_point,
+    const type_info* class_info,
+    const type_info* return_info,
+    const type_info* type_infos,
+    const std::size_t* parameter_type_indices,
+    const bool* pointer_flags,
+    Iterator first,
+    Iterator last)
+    : manager_(manager),
+      free_bind_point_(free_bind_point),
+      member_bind_point_(member_bind_point),
+      class_info_(class_info),
+      return_info_(return_info),
+      pointer_flags_(pointer_flags),
+      parameter_infos_(),
+      arguments_(),
+      pointees_()
+{
+    for(auto flag_ptr = pointer_flags; first != last;
+        ++first, ++flag_ptr, ++parameter_type_indices)
+    {
+        parameter_infos_.push_back(type_infos + *parameter_type_indices);
+
+        if(*flag_ptr)
+        {
+            arguments_.emplace_back();
+            pointees_.push_back(first->value_);
+        }
+        else
+        {
+            arguments_.push_back(first->value_);
+            pointees_.emplace_back();
+        }
+    }
+
+    bind_pointers();
+}
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "api_types.hpp"
+#include "exceptions.hpp"
+#include "reflection_manager.hpp"
+
+
+namespace shadow
+{
+// objects of a registered standard layout type stored by column, each
+// registered member variable in its own contiguous array
+// scans over a few member variables only touch the memory of their columns,
+// and rows are reconstructed as objects on demand
+class column_store
+{
+public:
+    // empty store for objects of type tag
+    // throws type_error if the type isn't standard layout or any of its
+    // member variables isn't trivially copyable or is over aligned
+    column_store(const reflection_manager& manager, const type_tag& tag);
+
+public:
+    // number of rows
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    bool
+    empty() const
+    {
+        return size_ == 0;
+    }
+
+    type_tag
+    type() const
+    {
+        return type_;
+    }
+
+    void reserve(std::size_t rows);
+
+    void clear();
+
+    // append the member variables of the value held by obj as a new row
+    // throws type_error if obj holds a value of another type
+    void push_back(const object& obj);
+
+    // values of field in row order
+    // throws type_error if field doesn't belong to the stored type or T
+    // isn't the type of field
+    template <class T>
+    std::pair<const T*, const T*>
+    column(const member_variable_tag& field) const;
+
+    template <class T>
+    std::pair<T*, T*> column(const member_variable_tag& field);
+
+    // object holding the value of row at index, default constructed and with
+    // its registered member variables copied from the columns
+    // throws argument_error if index is out of range, and type_error if the
+    // type has no registered default constructor
+    object row(std::size_t index) const;
+
+private:
+    struct column_data
+    {
+        member_variable_tag field;
+        std::size_t offset;
+        std::size_t size;
+        // allocated by operator new, so aligned for any fundamental type
+        std::vector<char> bytes;
+    };
+
+    // column of field, throws type_error if it doesn't belong to the type
+    const column_data& column_of(const member_variable_tag& field) const;
+
+    template <class T>
+    const column_data& typed_column_of(const member_variable_tag& field) const;
+
+private:
+    const reflection_manager* manager_;
+    type_tag type_;
+    std::vector<column_data> columns_;
+    std::size_t size_;
+    // registered default constructor of type_, used by row
+    bool has_default_constructor_;
+    constructor_tag default_constructor_;
+};
+
+
+template <class T>
+inline const column_store::column_data&
+column_store::typed_column_of(const member_variable_tag& field) const
+{
+    const auto& col = column_of(field);
+
+    if(!manager_->type_is<T>(manager_->member_variable_type(col.field)))
+    {
+        throw type_error("column type doesn't match member variable type");
+    }
+
+    return col;
+}
+
+template <class T>
+inline std::pair<const T*, const T*>
+column_store::column(const member_variable_tag& field) const
+{
+    const auto& col = typed_column_of<T>(field);
+    const auto first = reinterpret_cast<const T*>(col.bytes.data());
+
+    return std::make_pair(first, first + size_);
+}
+
+template <class T>
+inline std::pair<T*, T*>
+column_store::column(const member_variable_tag& field)
+{
+    auto& col = const_cast<column_data&>(typed_column_of<T>(field));
+    const auto first = reinterpret_cast<T*>(col.bytes.data());
+
+    return std::make_pair(first, first + size_);
+}
+}
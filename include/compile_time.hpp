@@ -3,6 +3,7 @@
 
 
 #include <string>
+#include <type_traits>
 
 #include <function_deduction.hpp>
 #include <integer_sequence.hpp>
@@ -62,7 +63,16 @@ struct extract_type_info
         &pointer_detail::generic_address_of_bind_point<
             typename CompileTimeTypeInfo::type>,
         &pointer_detail::generic_dereference_bind_point<
-            typename CompileTimeTypeInfo::type>};
+            typename CompileTimeTypeInfo::type>,
+        hash_name(CompileTimeTypeInfo::name),
+        sizeof(CompileTimeTypeInfo::name) - 1,
+        std::is_trivially_copyable<typename CompileTimeTypeInfo::type>::value,
+        pointer_detail::generic_assign_bind_point_of<
+            typename CompileTimeTypeInfo::type>(),
+        std::is_standard_layout<typename CompileTimeTypeInfo::type>::value,
+        CompileTimeTypeInfo::alignment,
+        pointer_detail::generic_operations_of<
+            typename CompileTimeTypeInfo::type>()};
 };
 
 template <class TypeListOfCompileTimeTypeInfo>
@@ -197,7 +207,12 @@ struct extract_free_function_info
         metamusil::t_list::length_v<typename CTFFI::parameter_list>,
         CTFFI::parameter_type_indices_holder::value,
         CTFFI::parameter_pointer_flags_holder::value,
-        CTFFI::bind_point};
+        CTFFI::bind_point,
+        sizeof(CTFFI::name) - 1,
+        CTFFI::invoke_bind_point,
+        CTFFI::parameter_writable_flags_holder::value,
+        CTFFI::batch_bind_point,
+        CTFFI::batch_kernel_bind_point};
 };
 
 template <class CompileTimeFfInfoList>
@@ -217,7 +232,9 @@ struct extract_member_function_info
         CTMFI::num_parameters,
         CTMFI::parameter_type_indices_holder::value,
         CTMFI::parameter_pointer_flags_holder::value,
-        CTMFI::bind_point};
+        CTMFI::bind_point,
+        sizeof(CTMFI::name) - 1,
+        CTMFI::batch_bind_point};
 };
 
 template <class CompileTimeMfInfoList>
@@ -234,7 +251,8 @@ struct extract_member_variable_info
                                                    CTMVI::type_index,
                                                    CTMVI::offset,
                                                    CTMVI::get_bind_point,
-                                                   CTMVI::set_bind_point};
+                                                   CTMVI::set_bind_point,
+                                                   sizeof(CTMVI::name) - 1};
 };
 
 template <class CompileTimeMvInfoList>
@@ -263,7 +281,13 @@ struct generate_array_of_serialization_info
             "default",
             metamusil::t_list::index_of_type_v<Types, T>,
             &serialization_detail::generic_serialization_bind_point<T>,
-            &serialization_detail::generic_deserialization_bind_point<T>};
+            &serialization_detail::generic_deserialization_bind_point<T>,
+            &serialization_detail::generic_binary_serialization_bind_point<T>,
+            &serialization_detail::
+                generic_binary_deserialization_bind_point<T>,
+            &serialization_detail::generic_text_serialization_bind_point<T>,
+            &serialization_detail::
+                generic_text_deserialization_bind_point<T>};
     };
 
 
@@ -300,6 +324,7 @@ using generate_array_of_serialization_info_t =
         typedef type_name type;                                                \
         static constexpr char name[] = #type_name;                             \
         static const std::size_t size = sizeof(type_name);                     \
+        static const std::size_t alignment = alignof(type_name);               \
     };                                                                         \
                                                                                \
     /* definition required for static member */                                \
@@ -340,6 +365,7 @@ using generate_array_of_serialization_info_t =
         typedef void type;                                                     \
         static constexpr char name[] = "void";                                 \
         static const std::size_t size = 0;                                     \
+        static const std::size_t alignment = 0;                                \
     };                                                                         \
     constexpr char fundamental_compile_time_info<void>::name[];
 
@@ -351,6 +377,7 @@ using generate_array_of_serialization_info_t =
         typedef type_name type;                                                \
         static constexpr char name[] = #type_name;                             \
         static const std::size_t size = sizeof(type_name);                     \
+        static const std::size_t alignment = alignof(type_name);               \
     };                                                                         \
                                                                                \
     constexpr char fundamental_compile_time_info<type_name>::name[];
@@ -588,7 +615,60 @@ using generate_array_of_serialization_info_t =
     struct exp_compile_time_ff_info;
 
 
-#define REGISTER_FREE_FUNCTION(function_name)                                  \
+// members shared by the REGISTER_FREE_FUNCTION macros, generated from the
+// typedefs function_pointer_type and parameter_list of the enclosing info
+// kernel_bind_point is nullptr, or SHADOW_FREE_FUNCTION_KERNEL of a kernel
+#define SHADOW_FREE_FUNCTION_INFO_MEMBERS(function_name, kernel_bind_point)    \
+                                                                               \
+    typedef metamusil::t_list::type_transform_t<parameter_list,                \
+                                                metamusil::base_t>             \
+        base_parameter_list;                                                   \
+                                                                               \
+    typedef metamusil::t_list::order_t<base_parameter_list, type_universe>     \
+        parameter_index_sequence;                                              \
+                                                                               \
+    typedef metamusil::int_seq::integer_sequence_to_array<                     \
+        parameter_index_sequence>                                              \
+        parameter_type_indices_holder;                                         \
+                                                                               \
+    typedef metamusil::t_list::value_transform<parameter_list,                 \
+                                               std::is_pointer>                \
+        parameter_pointer_flags_holder;                                        \
+                                                                               \
+    typedef metamusil::t_list::value_transform<                                \
+        parameter_list,                                                        \
+        shadow::free_function_detail::is_writable_parameter>                   \
+        parameter_writable_flags_holder;                                       \
+                                                                               \
+    static constexpr shadow::free_function_binding_signature bind_point =      \
+        &shadow::free_function_detail::generic_free_function_bind_point<       \
+            function_pointer_type,                                             \
+            &function_name>;                                                   \
+                                                                               \
+    static constexpr shadow::free_function_invoke_signature                    \
+        invoke_bind_point = &shadow::free_function_detail::                    \
+            generic_free_function_invoke_bind_point<function_pointer_type,     \
+                                                    &function_name>;           \
+                                                                               \
+    static constexpr shadow::free_function_batch_signature batch_bind_point =  \
+        shadow::free_function_detail::                                         \
+            generic_free_function_batch_bind_point_of<function_pointer_type,   \
+                                                      &function_name>();       \
+                                                                               \
+    static constexpr shadow::free_function_batch_signature                     \
+        batch_kernel_bind_point = kernel_bind_point;
+
+
+// batch bind point calling kernel_name, for SHADOW_FREE_FUNCTION_INFO_MEMBERS
+// kernel_name is converted to the kernel signature of function_pointer_type,
+// which picks the right overload of an overloaded kernel
+#define SHADOW_FREE_FUNCTION_KERNEL(kernel_name)                               \
+    (&shadow::free_function_detail::generic_free_function_kernel_bind_point<   \
+        function_pointer_type,                                                 \
+        &kernel_name>)
+
+
+#define SHADOW_REGISTER_FREE_FUNCTION(function_name, kernel_bind_point)        \
                                                                                \
     template <>                                                                \
     struct compile_time_ff_info<__LINE__>                                      \
@@ -605,31 +685,14 @@ using generate_array_of_serialization_info_t =
         typedef metamusil::deduce_parameter_types_t<function_pointer_type>     \
             parameter_list;                                                    \
                                                                                \
-        typedef metamusil::t_list::type_transform_t<parameter_list,            \
-                                                    metamusil::base_t>         \
-            base_parameter_list;                                               \
-                                                                               \
-        typedef metamusil::t_list::order_t<base_parameter_list, type_universe> \
-            parameter_index_sequence;                                          \
-                                                                               \
-        typedef metamusil::int_seq::integer_sequence_to_array<                 \
-            parameter_index_sequence>                                          \
-            parameter_type_indices_holder;                                     \
-                                                                               \
-        typedef metamusil::t_list::value_transform<parameter_list,             \
-                                                   std::is_pointer>            \
-            parameter_pointer_flags_holder;                                    \
-                                                                               \
-        static constexpr shadow::free_function_binding_signature bind_point =  \
-            &shadow::free_function_detail::generic_free_function_bind_point<   \
-                decltype(&function_name),                                      \
-                &function_name>;                                               \
+        SHADOW_FREE_FUNCTION_INFO_MEMBERS(function_name, kernel_bind_point)    \
     };                                                                         \
                                                                                \
     constexpr char compile_time_ff_info<__LINE__>::name[];
 
 
-#define REGISTER_FREE_FUNCTION_EXPLICIT(function_name, return_type, ...)       \
+#define SHADOW_REGISTER_FREE_FUNCTION_EXPLICIT(                                \
+    function_name, kernel_bind_point, return_type, ...)                        \
                                                                                \
     template <>                                                                \
     struct exp_compile_time_ff_info<__LINE__>                                  \
@@ -643,30 +706,43 @@ using generate_array_of_serialization_info_t =
                                                                                \
         typedef metamusil::t_list::type_list<__VA_ARGS__> parameter_list;      \
                                                                                \
-        typedef metamusil::t_list::type_transform_t<parameter_list,            \
-                                                    metamusil::base_t>         \
-            base_parameter_list;                                               \
-                                                                               \
-        typedef metamusil::t_list::order_t<base_parameter_list, type_universe> \
-            parameter_index_sequence;                                          \
-                                                                               \
-        typedef metamusil::int_seq::integer_sequence_to_array<                 \
-            parameter_index_sequence>                                          \
-            parameter_type_indices_holder;                                     \
-                                                                               \
-        typedef metamusil::t_list::value_transform<parameter_list,             \
-                                                   std::is_pointer>            \
-            parameter_pointer_flags_holder;                                    \
-                                                                               \
-        static constexpr shadow::free_function_binding_signature bind_point =  \
-            &shadow::free_function_detail::generic_free_function_bind_point<   \
-                function_pointer_type,                                         \
-                &function_name>;                                               \
+        SHADOW_FREE_FUNCTION_INFO_MEMBERS(function_name, kernel_bind_point)    \
     };                                                                         \
                                                                                \
     constexpr char exp_compile_time_ff_info<__LINE__>::name[];
 
 
+#define REGISTER_FREE_FUNCTION(function_name)                                  \
+    SHADOW_REGISTER_FREE_FUNCTION(function_name, nullptr)
+
+
+// as REGISTER_FREE_FUNCTION, with kernel_name called by the batch calls in
+// place of the generated loop, eg. a vectorized implementation. For
+// R function_name(P...) it is void kernel_name(R* results, C... columns,
+// std::size_t rows), without results for functions returning void, where C is
+// const T* for parameters taking T by value or const reference, and T* for
+// non-const reference or pointer parameters.
+#define REGISTER_FREE_FUNCTION_WITH_BATCH_KERNEL(function_name, kernel_name)   \
+    SHADOW_REGISTER_FREE_FUNCTION(function_name,                               \
+                                  SHADOW_FREE_FUNCTION_KERNEL(kernel_name))
+
+
+#define REGISTER_FREE_FUNCTION_EXPLICIT(function_name, return_type, ...)       \
+    SHADOW_REGISTER_FREE_FUNCTION_EXPLICIT(                                    \
+        function_name, nullptr, return_type, __VA_ARGS__)
+
+
+// as REGISTER_FREE_FUNCTION_WITH_BATCH_KERNEL, for overloaded or templated
+// functions, with the signature given as for REGISTER_FREE_FUNCTION_EXPLICIT
+#define REGISTER_FREE_FUNCTION_EXPLICIT_WITH_BATCH_KERNEL(                     \
+    function_name, kernel_name, return_type, ...)                              \
+    SHADOW_REGISTER_FREE_FUNCTION_EXPLICIT(                                    \
+        function_name,                                                         \
+        SHADOW_FREE_FUNCTION_KERNEL(kernel_name),                              \
+        return_type,                                                           \
+        __VA_ARGS__)
+
+
 #define REGISTER_FREE_FUNCTION_END()                                           \
     constexpr std::size_t ff_line_end = __LINE__;                              \
                                                                                \
@@ -755,6 +831,12 @@ using generate_array_of_serialization_info_t =
                              generic_member_function_bind_point<               \
                                  member_function_signature_type,               \
                                  &class_name::function_name>;                  \
+                                                                               \
+        static constexpr shadow::member_function_batch_signature               \
+            batch_bind_point = shadow::member_function_detail::                \
+                generic_member_function_batch_bind_point_of<                   \
+                    member_function_signature_type,                            \
+                    &class_name::function_name>();                             \
     };                                                                         \
                                                                                \
                                                                                \
@@ -809,6 +891,12 @@ using generate_array_of_serialization_info_t =
                              generic_member_function_bind_point<               \
                                  member_function_signature_type,               \
                                  &class_name::function_name>;                  \
+                                                                               \
+        static constexpr shadow::member_function_batch_signature               \
+            batch_bind_point = shadow::member_function_detail::                \
+                generic_member_function_batch_bind_point_of<                   \
+                    member_function_signature_type,                            \
+                    &class_name::function_name>();                             \
     };                                                                         \
                                                                                \
     constexpr char exp_compile_time_mf_info<__LINE__>::name[];
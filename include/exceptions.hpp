@@ -16,4 +16,11 @@ class type_error : public std::runtime_error
 public:
     using std::runtime_error::runtime_error;
 };
+
+
+class serialization_error : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
 }
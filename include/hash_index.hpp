@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace shadow
+{
+// 64 bit FNV-1a hash of null terminated string, usable at compile time
+constexpr std::uint64_t
+hash_name(const char* name)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+
+    for(; *name != '\0'; ++name)
+    {
+        hash = (hash ^ static_cast<unsigned char>(*name)) * 1099511628211ull;
+    }
+
+    return hash;
+}
+
+// same hash for the first size chars of name, which need not be null
+// terminated
+constexpr std::uint64_t
+hash_name(const char* name, std::size_t size)
+{
+    std::uint64_t hash = 14695981039346656037ull;
+
+    for(std::size_t i = 0; i < size; ++i)
+    {
+        hash = (hash ^ static_cast<unsigned char>(name[i])) * 1099511628211ull;
+    }
+
+    return hash;
+}
+
+// mix value into hash seed, used to key names scoped to a type by both
+constexpr std::uint64_t
+combine_hash(std::uint64_t seed, std::uint64_t value)
+{
+    return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+}
+
+
+// open addressing hash table from 64 bit hashes to indices into an array of
+// reflection information
+// it is filled once when the reflection_manager is constructed and only read
+// after that. Several indices may share a hash, so lookups take a predicate
+// deciding whether the index found is the one searched for.
+class hash_index
+{
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+public:
+    hash_index() : slots_(), mask_(0)
+    {
+    }
+
+    // make room for num_entries indices, keeping the load factor at most 0.5
+    explicit hash_index(std::size_t num_entries) : slots_(), mask_(0)
+    {
+        std::size_t capacity = 1;
+        while(capacity < num_entries * 2)
+        {
+            capacity *= 2;
+        }
+
+        slots_.resize(capacity, slot{0, npos});
+        mask_ = capacity - 1;
+    }
+
+    void
+    insert(std::uint64_t hash, std::size_t index)
+    {
+        auto position = hash & mask_;
+
+        while(slots_[position].index != npos)
+        {
+            position = (position + 1) & mask_;
+        }
+
+        slots_[position] = slot{hash, index};
+    }
+
+    // returns first index with the given hash for which pred(index) is true,
+    // or npos if there is none
+    template <class Predicate>
+    std::size_t
+    find(std::uint64_t hash, Predicate&& pred) const
+    {
+        if(slots_.empty())
+        {
+            return npos;
+        }
+
+        for(auto position = hash & mask_; slots_[position].index != npos;
+            position = (position + 1) & mask_)
+        {
+            if(slots_[position].hash == hash && pred(slots_[position].index))
+            {
+                return slots_[position].index;
+            }
+        }
+
+        return npos;
+    }
+
+private:
+    struct slot
+    {
+        std::uint64_t hash;
+        std::size_t index;
+    };
+
+    std::vector<slot> slots_;
+    std::size_t mask_;
+};
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+namespace shadow
+{
+// read only view of the contents of a file
+// the file is memory mapped where the platform supports it (POSIX), otherwise
+// it is read into a buffer owned by the mapped_file
+class mapped_file
+{
+public:
+    // throws std::system_error if the file can't be opened or mapped
+    explicit mapped_file(const std::string& path);
+
+    mapped_file(mapped_file&& other) noexcept;
+    mapped_file& operator=(mapped_file&& other) noexcept;
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    ~mapped_file();
+
+public:
+    const char*
+    data() const
+    {
+        return data_;
+    }
+
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    // true if data() points to a memory mapping rather than a buffer
+    bool
+    is_mapped() const
+    {
+        return mapped_;
+    }
+
+private:
+    void unmap();
+
+private:
+    const char* data_;
+    std::size_t size_;
+    bool mapped_;
+    std::vector<char> buffer_;
+};
+}
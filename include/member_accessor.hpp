@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+
+#include "api_types.hpp"
+
+
+namespace shadow
+{
+// typed access to a member variable of a standard layout class through its
+// offset, made by reflection_manager::member_variable_accessor
+// the type and layout checks are done once when the accessor is made, each
+// access is then a plain load or store at the offset within the object
+template <class T>
+class member_accessor
+{
+    friend class reflection_manager;
+
+public:
+    // unchecked, obj must hold a value of the class type of the member variable
+    T&
+    get(object& obj) const
+    {
+        return *reinterpret_cast<T*>(static_cast<char*>(obj.value_.data()) +
+                                     offset_);
+    }
+
+    const T&
+    get(const object& obj) const
+    {
+        return *reinterpret_cast<const T*>(
+            static_cast<const char*>(obj.value_.data()) + offset_);
+    }
+
+    void
+    set(object& obj, const T& val) const
+    {
+        get(obj) = val;
+    }
+
+    // offset in bytes of the member variable within its class
+    std::size_t
+    offset() const
+    {
+        return offset_;
+    }
+
+private:
+    explicit member_accessor(std::size_t offset) : offset_(offset)
+    {
+    }
+
+private:
+    std::size_t offset_;
+};
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <type_traits>
+
+#include "api_types.hpp"
+#include "reflection_info.hpp"
+
+
+namespace shadow
+{
+class reflection_manager;
+
+
+// non-owning reference to a member variable within the value held by an
+// object, made by reflection_manager::member_variable_reference
+// it is valid for as long as the object holds the same value, ie. until the
+// object is assigned to, moved from or destroyed
+// Pointer is void* for mutable references and const void* for const ones
+template <class Pointer>
+class basic_member_reference
+{
+    friend class reflection_manager;
+
+public:
+    // type of the referenced member variable
+    type_tag
+    type() const
+    {
+        return type_tag(*type_info_);
+    }
+
+    // address of the referenced member variable
+    Pointer
+    address() const
+    {
+        return address_;
+    }
+
+    // unchecked access to the referenced value, T must be its type
+    template <class T>
+    std::conditional_t<std::is_const<std::remove_pointer_t<Pointer>>::value,
+                       const T&,
+                       T&>
+    get() const
+    {
+        typedef std::conditional_t<
+            std::is_const<std::remove_pointer_t<Pointer>>::value,
+            const T*,
+            T*>
+            pointer_type;
+
+        return *static_cast<pointer_type>(address_);
+    }
+
+    // mutable references convert to const ones
+    operator basic_member_reference<const void*>() const
+    {
+        return basic_member_reference<const void*>(address_, type_info_);
+    }
+
+private:
+    template <class>
+    friend class basic_member_reference;
+
+    basic_member_reference(Pointer address, const type_info* info)
+        : address_(address), type_info_(info)
+    {
+    }
+
+private:
+    Pointer address_;
+    const type_info* type_info_;
+};
+
+
+typedef basic_member_reference<void*> member_reference;
+typedef basic_member_reference<const void*> const_member_reference;
+}
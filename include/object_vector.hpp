@@ -0,0 +1,222 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+
+#include "api_types.hpp"
+#include "exceptions.hpp"
+#include "reflection_manager.hpp"
+
+
+namespace shadow
+{
+// contiguous array of values of one registered type
+// unlike std::vector<object> the type and manager are stored once, and the
+// values are laid out back to back with the size and alignment of the type
+// instead of each being held by its own any
+// elements are accessed through references to objects referring to the
+// values in place, so they can be passed to the member function and member
+// variable functions of the reflection_manager without copying the values
+class object_vector
+{
+public:
+    typedef object_reference reference;
+    typedef const_object_reference const_reference;
+
+    template <class Vector, class Reference>
+    class basic_iterator;
+
+    typedef basic_iterator<object_vector, reference> iterator;
+    typedef basic_iterator<const object_vector, const_reference> const_iterator;
+
+public:
+    // empty vector of values of type tag
+    // throws type_error if values of the type can't be copied or need more
+    // alignment than operator new provides
+    object_vector(const reflection_manager& manager, const type_tag& tag);
+
+    object_vector(const object_vector& other);
+    object_vector(object_vector&& other) noexcept;
+
+    object_vector& operator=(const object_vector& other);
+    object_vector& operator=(object_vector&& other) noexcept;
+
+    ~object_vector();
+
+public:
+    std::size_t
+    size() const
+    {
+        return size_;
+    }
+
+    bool
+    empty() const
+    {
+        return size_ == 0;
+    }
+
+    std::size_t
+    capacity() const
+    {
+        return capacity_;
+    }
+
+    type_tag
+    type() const
+    {
+        return type_tag(*type_info_);
+    }
+
+    void reserve(std::size_t new_capacity);
+
+    void clear();
+
+    // remove values past new_size, or append copies of the value held by
+    // value up to new_size
+    // throws type_error if value holds a value of another type
+    void resize(std::size_t new_size, const object& value);
+
+    // append copy of the value held by obj
+    // throws type_error if obj holds a value of another type
+    void push_back(const object& obj);
+
+    void pop_back();
+
+    // reference to the value at index, valid until the value is removed or
+    // the vector reallocates
+    reference operator[](std::size_t index);
+    const_reference operator[](std::size_t index) const;
+
+    // as above, but throws argument_error if index is out of range
+    reference at(std::size_t index);
+    const_reference at(std::size_t index) const;
+
+    // address of the first value
+    void*
+    data()
+    {
+        return data_;
+    }
+
+    const void*
+    data() const
+    {
+        return data_;
+    }
+
+    iterator begin();
+    iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+
+private:
+    void* address_of(std::size_t index) const;
+
+    // object referring to the value at address, without owning it
+    object element_at(void* address) const;
+
+    // copy construct value at src into uninitialized storage at dst
+    void copy_value(const void* src, void* dst) const;
+
+    // move count values from src to uninitialized storage at dst, leaving
+    // src uninitialized
+    // values whose move may throw are copied instead, and if a copy throws
+    // the values at src are left as they were and dst uninitialized
+    void relocate(char* src, char* dst, std::size_t count) const;
+
+    // destroy values in [first, last) of this vector
+    void destroy(std::size_t first, std::size_t last);
+
+    char* allocate(std::size_t capacity) const;
+
+private:
+    const reflection_manager* manager_;
+    const type_info* type_info_;
+    char* data_;
+    std::size_t size_;
+    std::size_t capacity_;
+};
+
+
+// iterator yielding references to the values of an object_vector
+template <class Vector, class Reference>
+class object_vector::basic_iterator
+{
+public:
+    typedef std::input_iterator_tag iterator_category;
+    typedef object value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef void pointer;
+    typedef Reference reference;
+
+public:
+    basic_iterator() : vector_(nullptr), index_(0)
+    {
+    }
+
+    basic_iterator(Vector* vector, std::size_t index)
+        : vector_(vector), index_(index)
+    {
+    }
+
+    Reference operator*() const
+    {
+        return (*vector_)[index_];
+    }
+
+    basic_iterator& operator++()
+    {
+        ++index_;
+        return *this;
+    }
+
+    basic_iterator operator++(int)
+    {
+        auto out = *this;
+        ++index_;
+        return out;
+    }
+
+    bool
+    operator==(const basic_iterator& other) const
+    {
+        return vector_ == other.vector_ && index_ == other.index_;
+    }
+
+    bool
+    operator!=(const basic_iterator& other) const
+    {
+        return !operator==(other);
+    }
+
+private:
+    Vector* vector_;
+    std::size_t index_;
+};
+
+
+inline object_vector::iterator
+object_vector::begin()
+{
+    return iterator(this, 0);
+}
+
+inline object_vector::iterator
+object_vector::end()
+{
+    return iterator(this, size_);
+}
+
+inline object_vector::const_iterator
+object_vector::begin() const
+{
+    return const_iterator(this, 0);
+}
+
+inline object_vector::const_iterator
+object_vector::end() const
+{
+    return const_iterator(this, size_);
+}
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "api_types.hpp"
+#include "exceptions.hpp"
+#include "reflection_manager.hpp"
+
+
+namespace shadow
+{
+// field of the records of a record_view known to be of type T, made by
+// record_view::typed_field to read the field without checking it again
+template <class T>
+class record_field
+{
+    friend class record_view;
+
+private:
+    explicit record_field(std::size_t offset) : offset_(offset)
+    {
+    }
+
+private:
+    std::size_t offset_;
+};
+
+
+// read only view of packed records of a registered trivially copyable type,
+// eg. the contents of a mapped_file
+// fields are read in place through the offsets of the registered member
+// variables, without constructing objects or copying records
+class record_view
+{
+public:
+    // view size bytes at data as records of type tag
+    // throws type_error if the type or any of its member variables isn't
+    // trivially copyable, and serialization_error if size isn't a multiple of
+    // the size of the type or a member variable doesn't fit within a record
+    record_view(const reflection_manager& manager,
+                const type_tag& tag,
+                const void* data,
+                std::size_t size);
+
+    // as above, and throws serialization_error if schema_hash, eg. stored with
+    // the data by its writer, isn't the type_schema_hash of the type
+    record_view(const reflection_manager& manager,
+                const type_tag& tag,
+                const void* data,
+                std::size_t size,
+                std::uint64_t schema_hash);
+
+public:
+    // number of records
+    std::size_t
+    size() const
+    {
+        return num_records_;
+    }
+
+    type_tag
+    type() const
+    {
+        return type_;
+    }
+
+    // start of record at index
+    const void* record(std::size_t index) const;
+
+    // start of field within record at index
+    // throws argument_error if index is out of range and type_error if field
+    // isn't a member variable of the viewed type
+    const void*
+    field(std::size_t index, const member_variable_tag& field) const;
+
+    // handle to read field as T, checked once here rather than on each read
+    // throws type_error if field isn't a member variable of the viewed type or
+    // isn't of type T
+    template <class T>
+    record_field<T> typed_field(const member_variable_tag& field) const;
+
+    // copy of field within record at index
+    // throws argument_error if index is out of range
+    template <class T>
+    T get(std::size_t index, const record_field<T>& field) const;
+
+    // as above, checking field as typed_field does on every call
+    template <class T>
+    T get(std::size_t index, const member_variable_tag& field) const;
+
+private:
+    struct field_layout
+    {
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    // layout of field, throws type_error if it doesn't belong to the type
+    field_layout layout_of(const member_variable_tag& field) const;
+
+private:
+    const reflection_manager* manager_;
+    type_tag type_;
+    const char* data_;
+    std::size_t record_size_;
+    std::size_t num_records_;
+};
+
+
+template <class T>
+inline record_field<T>
+record_view::typed_field(const member_variable_tag& field) const
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "fields can only be read as trivially copyable types");
+
+    const auto layout = layout_of(field);
+
+    if(!manager_->type_is<T>(manager_->member_variable_type(field)))
+    {
+        throw type_error("type of field doesn't match requested type");
+    }
+
+    return record_field<T>(layout.offset);
+}
+
+template <class T>
+inline T
+record_view::get(std::size_t index, const record_field<T>& field) const
+{
+    T out;
+    std::memcpy(&out,
+                static_cast<const char*>(record(index)) + field.offset_,
+                sizeof(T));
+
+    return out;
+}
+
+template <class T>
+inline T
+record_view::get(std::size_t index, const member_variable_tag& field) const
+{
+    return get(index, typed_field<T>(field));
+}
+}
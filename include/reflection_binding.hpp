@@ -2,14 +2,21 @@
 #define REFLECTION_BINDING_HPP
 
 
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <type_traits>
 #include <utility>
 #include <istream>
 #include <ostream>
 #include <limits>
+#include <vector>
+#include <new>
 
 #include "any.hpp"
+#include "exceptions.hpp"
+#include "text_format.hpp"
 #include <function_deduction.hpp>
 #include <member_variable_deduction.hpp>
 #include <type_list.hpp>
@@ -20,8 +27,22 @@ namespace shadow
 {
 // free function signature
 typedef any (*free_function_binding_signature)(any*);
+// typed free function signature, takes storage for the return value and the
+// addresses of the arguments
+typedef void (*free_function_invoke_signature)(void*, void* const*);
+// batch free function signature, takes the return values, the argument
+// columns and the number of rows
+typedef void (*free_function_batch_signature)(void*,
+                                              void* const*,
+                                              std::size_t);
 // member function signature
 typedef any (*member_function_binding_signature)(any&, any*);
+// batch member function signature, takes the objects, their number, the
+// arguments and the return values
+typedef void (*member_function_batch_signature)(void*,
+                                                std::size_t,
+                                                any*,
+                                                void*);
 // member variable getter
 typedef any (*member_variable_get_binding_signature)(const any&);
 // member variable setter
@@ -34,10 +55,30 @@ typedef any (*conversion_binding_signature)(const any&);
 typedef any (*address_of_signature)(any&);
 // dereference signature
 typedef any (*dereference_signature)(any&);
+// assign signature, copy assigns the value at src to the value at dst
+typedef void (*assign_signature)(void*, const void*);
 // serialization signature
 typedef std::ostream& (*serialization_signature)(std::ostream&, const any&);
 // deserialization signature
 typedef std::istream& (*deserialization_signature)(std::istream&, any&);
+// binary serialization signature, appends bytes of the value at the given
+// address to buffer
+typedef void (*binary_serialization_signature)(std::vector<char>&,
+                                               const void*);
+// binary deserialization signature, reads value from range first -> last into
+// the value at the given address and returns pointer past the bytes read
+typedef const char* (*binary_deserialization_signature)(const char*,
+                                                        const char*,
+                                                        void*);
+// text serialization signature, writes text of the value at the given address
+// to range first -> last and returns pointer past the text, or nullptr if it
+// doesn't fit
+typedef char* (*text_serialization_signature)(char*, char*, const void*);
+// text deserialization signature, parses text from range first -> last into
+// the value at the given address and returns pointer past the text parsed
+typedef const char* (*text_deserialization_signature)(const char*,
+                                                      const char*,
+                                                      void*);
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -120,6 +161,320 @@ generic_free_function_bind_point(any* argument_array)
         template dispatch<FunctionPointerType, FunctionPointerValue>(
             argument_array, parameter_types(), parameter_sequence());
 }
+
+
+// as return_type_specializer, but for arguments held as raw values with the
+// parameter types rather than in anys
+template <class ReturnType>
+struct invoke_specializer
+{
+    template <class FunctionPointerType,
+              FunctionPointerType FunctionPointerValue,
+              class... ArgTypes,
+              std::size_t... ArgSeq>
+    static void
+    dispatch(void* result,
+             void* const* argument_array,
+             metamusil::t_list::type_list<ArgTypes...>,
+             std::index_sequence<ArgSeq...>)
+    {
+        new(result) ReturnType(FunctionPointerValue(
+            *static_cast<std::remove_reference_t<ArgTypes>*>(
+                argument_array[ArgSeq])...));
+    }
+};
+
+
+template <>
+struct invoke_specializer<void>
+{
+    template <class FunctionPointerType,
+              FunctionPointerType FunctionPointerValue,
+              class... ArgTypes,
+              std::size_t... ArgSeq>
+    static void
+    dispatch(void*,
+             void* const* argument_array,
+             metamusil::t_list::type_list<ArgTypes...>,
+             std::index_sequence<ArgSeq...>)
+    {
+        FunctionPointerValue(*static_cast<std::remove_reference_t<ArgTypes>*>(
+            argument_array[ArgSeq])...);
+    }
+};
+
+
+// typed trampoline with the same signature for all functions
+// argument_array holds the addresses of values of the parameter types without
+// references, and the return value is constructed in the uninitialized
+// storage at result, which is unused for functions returning void
+template <class FunctionPointerType, FunctionPointerType FunctionPointerValue>
+void
+generic_free_function_invoke_bind_point(void* result,
+                                        void* const* argument_array)
+{
+    typedef metamusil::deduce_return_type_t<FunctionPointerType> return_type;
+    typedef metamusil::deduce_parameter_types_t<FunctionPointerType>
+        parameter_types;
+    typedef metamusil::t_list::index_sequence_for_t<parameter_types>
+        parameter_sequence;
+
+    invoke_specializer<return_type>::
+        template dispatch<FunctionPointerType, FunctionPointerValue>(
+            result, argument_array, parameter_types(), parameter_sequence());
+}
+
+
+// true for parameters the function can write its argument through, which
+// must not be given const or temporary arguments
+template <class ParamType>
+struct is_writable_parameter
+    : std::integral_constant<
+          bool,
+          (std::is_reference<ParamType>::value &&
+           !std::is_const<std::remove_reference_t<ParamType>>::value) ||
+              (std::is_pointer<ParamType>::value &&
+               !std::is_const<std::remove_pointer_t<ParamType>>::value)>
+{
+};
+
+
+// element at row of a column of values for a parameter of type ParamType
+// pointer parameters get the address of the element, as with
+// call_free_function, other parameters the element itself
+template <class ParamType, class = void>
+struct batch_argument
+{
+    typedef std::remove_cv_t<std::remove_reference_t<ParamType>> value_type;
+
+    static value_type&
+    get(void* column, std::size_t row)
+    {
+        return static_cast<value_type*>(column)[row];
+    }
+};
+
+template <class ParamType>
+struct batch_argument<ParamType,
+                      std::enable_if_t<std::is_pointer<ParamType>::value>>
+{
+    typedef std::remove_cv_t<std::remove_pointer_t<ParamType>> value_type;
+
+    static value_type*
+    get(void* column, std::size_t row)
+    {
+        return static_cast<value_type*>(column) + row;
+    }
+};
+
+
+template <class ReturnType>
+struct batch_specializer
+{
+    template <class FunctionPointerType,
+              FunctionPointerType FunctionPointerValue,
+              class... ArgTypes,
+              std::size_t... ArgSeq>
+    static void
+    dispatch(void* results,
+             void* const* columns,
+             std::size_t rows,
+             metamusil::t_list::type_list<ArgTypes...>,
+             std::index_sequence<ArgSeq...>)
+    {
+        auto out = static_cast<ReturnType*>(results);
+
+        for(std::size_t row = 0; row < rows; ++row)
+        {
+            out[row] = FunctionPointerValue(
+                batch_argument<ArgTypes>::get(columns[ArgSeq], row)...);
+        }
+    }
+};
+
+template <>
+struct batch_specializer<void>
+{
+    template <class FunctionPointerType,
+              FunctionPointerType FunctionPointerValue,
+              class... ArgTypes,
+              std::size_t... ArgSeq>
+    static void
+    dispatch(void*,
+             void* const* columns,
+             std::size_t rows,
+             metamusil::t_list::type_list<ArgTypes...>,
+             std::index_sequence<ArgSeq...>)
+    {
+        for(std::size_t row = 0; row < rows; ++row)
+        {
+            FunctionPointerValue(
+                batch_argument<ArgTypes>::get(columns[ArgSeq], row)...);
+        }
+    }
+};
+
+
+// calls the function once per row, with argument i taken from row of
+// columns[i] and the return value assigned to row of results, which must hold
+// rows constructed values of the return type, or is unused for void
+template <class FunctionPointerType, FunctionPointerType FunctionPointerValue>
+void
+generic_free_function_batch_bind_point(void* results,
+                                       void* const* columns,
+                                       std::size_t rows)
+{
+    typedef metamusil::deduce_return_type_t<FunctionPointerType> return_type;
+    typedef metamusil::deduce_parameter_types_t<FunctionPointerType>
+        parameter_types;
+    typedef metamusil::t_list::index_sequence_for_t<parameter_types>
+        parameter_sequence;
+
+    batch_specializer<return_type>::
+        template dispatch<FunctionPointerType, FunctionPointerValue>(
+            results, columns, rows, parameter_types(), parameter_sequence());
+}
+
+// true if the return values can be assigned to a column of results
+template <class ReturnType>
+struct is_batch_return_type
+    : std::integral_constant<bool,
+                             std::is_void<ReturnType>::value ||
+                                 std::is_move_assignable<ReturnType>::value>
+{
+};
+
+// nullptr for functions whose return values can't be assigned to the results
+template <class FunctionPointerType, FunctionPointerType FunctionPointerValue>
+constexpr std::enable_if_t<
+    is_batch_return_type<
+        metamusil::deduce_return_type_t<FunctionPointerType>>::value,
+    free_function_batch_signature>
+generic_free_function_batch_bind_point_of()
+{
+    return &generic_free_function_batch_bind_point<FunctionPointerType,
+                                                   FunctionPointerValue>;
+}
+
+template <class FunctionPointerType, FunctionPointerType FunctionPointerValue>
+constexpr std::enable_if_t<
+    !is_batch_return_type<
+        metamusil::deduce_return_type_t<FunctionPointerType>>::value,
+    free_function_batch_signature>
+generic_free_function_batch_bind_point_of()
+{
+    return nullptr;
+}
+
+// column of a parameter as passed to a batch kernel, const for parameters that
+// aren't modified
+template <class ParamType, class = void>
+struct kernel_column
+{
+    typedef const std::remove_cv_t<std::remove_reference_t<ParamType>>* type;
+};
+
+template <class ParamType>
+struct kernel_column<ParamType&,
+                     std::enable_if_t<!std::is_const<ParamType>::value>>
+{
+    typedef ParamType* type;
+};
+
+template <class ParamType>
+struct kernel_column<ParamType*>
+{
+    typedef ParamType* type;
+};
+
+
+template <class ReturnType, class ParamTypes>
+struct kernel_signature;
+
+template <class ReturnType, class... ParamTypes>
+struct kernel_signature<ReturnType, metamusil::t_list::type_list<ParamTypes...>>
+{
+    typedef void (*type)(ReturnType*,
+                         typename kernel_column<ParamTypes>::type...,
+                         std::size_t);
+};
+
+template <class... ParamTypes>
+struct kernel_signature<void, metamusil::t_list::type_list<ParamTypes...>>
+{
+    typedef void (*type)(typename kernel_column<ParamTypes>::type...,
+                         std::size_t);
+};
+
+// signature of a batch kernel for the function of type FunctionPointerType
+template <class FunctionPointerType>
+using kernel_signature_t = typename kernel_signature<
+    metamusil::deduce_return_type_t<FunctionPointerType>,
+    metamusil::deduce_parameter_types_t<FunctionPointerType>>::type;
+
+
+template <class ReturnType>
+struct kernel_specializer
+{
+    template <class KernelType,
+              KernelType KernelValue,
+              class... ParamTypes,
+              std::size_t... ParamSeq>
+    static void
+    dispatch(void* results,
+             void* const* columns,
+             std::size_t rows,
+             metamusil::t_list::type_list<ParamTypes...>,
+             std::index_sequence<ParamSeq...>)
+    {
+        KernelValue(static_cast<ReturnType*>(results),
+                    static_cast<typename kernel_column<ParamTypes>::type>(
+                        columns[ParamSeq])...,
+                    rows);
+    }
+};
+
+template <>
+struct kernel_specializer<void>
+{
+    template <class KernelType,
+              KernelType KernelValue,
+              class... ParamTypes,
+              std::size_t... ParamSeq>
+    static void
+    dispatch(void*,
+             void* const* columns,
+             std::size_t rows,
+             metamusil::t_list::type_list<ParamTypes...>,
+             std::index_sequence<ParamSeq...>)
+    {
+        KernelValue(static_cast<typename kernel_column<ParamTypes>::type>(
+                        columns[ParamSeq])...,
+                    rows);
+    }
+};
+
+
+// passes the columns of a batch call on to a kernel registered for the
+// function of type FunctionPointerType
+template <class FunctionPointerType,
+          kernel_signature_t<FunctionPointerType> KernelValue>
+void
+generic_free_function_kernel_bind_point(void* results,
+                                        void* const* columns,
+                                        std::size_t rows)
+{
+    typedef metamusil::deduce_return_type_t<FunctionPointerType> return_type;
+    typedef metamusil::deduce_parameter_types_t<FunctionPointerType>
+        parameter_types;
+    typedef metamusil::t_list::index_sequence_for_t<parameter_types>
+        parameter_sequence;
+
+    kernel_specializer<return_type>::template dispatch<
+        kernel_signature_t<FunctionPointerType>,
+        KernelValue>(
+        results, columns, rows, parameter_types(), parameter_sequence());
+}
 } // namespace free_function_detail
 
 
@@ -192,6 +547,151 @@ generic_member_function_bind_point(any& object, any* argument_array)
         template dispatch<MemFunPointerType, MemFunPointerValue, object_type>(
             object, argument_array, parameter_types(), parameter_sequence());
 }
+
+
+// the arguments are taken out of the argument array once, so each object costs
+// a direct call of the member function
+template <class ReturnType>
+struct batch_specializer
+{
+    template <class MemFunPointerType,
+              MemFunPointerType MemFunPointerValue,
+              class ObjectType,
+              class... ParamTypes,
+              std::size_t... ParamSequence>
+    static void
+    dispatch(void* objects,
+             std::size_t count,
+             any* argument_array,
+             void* results,
+             metamusil::t_list::type_list<ParamTypes...>,
+             std::index_sequence<ParamSequence...>)
+    {
+        loop<MemFunPointerType, MemFunPointerValue, ObjectType, ParamTypes...>(
+            static_cast<ObjectType*>(objects),
+            count,
+            static_cast<ReturnType*>(results),
+            argument_array[ParamSequence]
+                .get<std::remove_reference_t<ParamTypes>>()...);
+    }
+
+    template <class MemFunPointerType,
+              MemFunPointerType MemFunPointerValue,
+              class ObjectType,
+              class... ParamTypes>
+    static void
+    loop(ObjectType* objects,
+         std::size_t count,
+         ReturnType* results,
+         std::remove_reference_t<ParamTypes>&... arguments)
+    {
+        if(results == nullptr)
+        {
+            for(std::size_t index = 0; index < count; ++index)
+            {
+                (objects[index].*MemFunPointerValue)(arguments...);
+            }
+
+            return;
+        }
+
+        for(std::size_t index = 0; index < count; ++index)
+        {
+            results[index] = (objects[index].*MemFunPointerValue)(arguments...);
+        }
+    }
+};
+
+template <>
+struct batch_specializer<void>
+{
+    template <class MemFunPointerType,
+              MemFunPointerType MemFunPointerValue,
+              class ObjectType,
+              class... ParamTypes,
+              std::size_t... ParamSequence>
+    static void
+    dispatch(void* objects,
+             std::size_t count,
+             any* argument_array,
+             void*,
+             metamusil::t_list::type_list<ParamTypes...>,
+             std::index_sequence<ParamSequence...>)
+    {
+        loop<MemFunPointerType, MemFunPointerValue, ObjectType, ParamTypes...>(
+            static_cast<ObjectType*>(objects),
+            count,
+            argument_array[ParamSequence]
+                .get<std::remove_reference_t<ParamTypes>>()...);
+    }
+
+    template <class MemFunPointerType,
+              MemFunPointerType MemFunPointerValue,
+              class ObjectType,
+              class... ParamTypes>
+    static void
+    loop(ObjectType* objects,
+         std::size_t count,
+         std::remove_reference_t<ParamTypes>&... arguments)
+    {
+        for(std::size_t index = 0; index < count; ++index)
+        {
+            (objects[index].*MemFunPointerValue)(arguments...);
+        }
+    }
+};
+
+
+// calls the member function with the same arguments on each of count objects
+// of its class stored contiguously, assigning the return values to results,
+// which must hold count constructed values of the return type, or be nullptr
+// to discard them
+template <class MemFunPointerType, MemFunPointerType MemFunPointerValue>
+void
+generic_member_function_batch_bind_point(void* objects,
+                                         std::size_t count,
+                                         any* argument_array,
+                                         void* results)
+{
+    typedef metamusil::deduce_return_type_t<MemFunPointerType> return_type;
+    typedef metamusil::deduce_parameter_types_t<MemFunPointerType>
+        parameter_types;
+    typedef metamusil::t_list::index_sequence_for_t<parameter_types>
+        parameter_sequence;
+    typedef metamusil::deduce_object_type_t<MemFunPointerType> object_type;
+
+    batch_specializer<return_type>::
+        template dispatch<MemFunPointerType, MemFunPointerValue, object_type>(
+            objects,
+            count,
+            argument_array,
+            results,
+            parameter_types(),
+            parameter_sequence());
+}
+
+// nullptr for member functions whose return values can't be assigned to the
+// results
+template <class MemFunPointerType, MemFunPointerType MemFunPointerValue>
+constexpr std::enable_if_t<
+    free_function_detail::is_batch_return_type<
+        metamusil::deduce_return_type_t<MemFunPointerType>>::value,
+    member_function_batch_signature>
+generic_member_function_batch_bind_point_of()
+{
+    return &generic_member_function_batch_bind_point<MemFunPointerType,
+                                                     MemFunPointerValue>;
+}
+
+template <class MemFunPointerType, MemFunPointerType MemFunPointerValue>
+constexpr std::enable_if_t<
+    !free_function_detail::is_batch_return_type<
+        metamusil::deduce_return_type_t<MemFunPointerType>>::value,
+    member_function_batch_signature>
+generic_member_function_batch_bind_point_of()
+{
+    return nullptr;
+}
 } // namespace member_function_detail
 
 
@@ -365,10 +865,371 @@ generic_dereference_bind_point<void>(any&)
     return any();
 }
 
+template <class T>
+inline void
+generic_assign_bind_point(void* dst, const void* src)
+{
+    *static_cast<T*>(dst) = *static_cast<const T*>(src);
+}
+
+// nullptr for types that can't be copy assigned, eg. void
+template <class T>
+constexpr std::enable_if_t<std::is_copy_assignable<T>::value, assign_signature>
+generic_assign_bind_point_of()
+{
+    return &generic_assign_bind_point<T>;
+}
+
+template <class T>
+constexpr std::enable_if_t<!std::is_copy_assignable<T>::value,
+                           assign_signature>
+generic_assign_bind_point_of()
+{
+    return nullptr;
+}
+
+// copy, move and destroy operations of any, for managing values in storage
+// other than an any, nullptr for types that can't be copied, eg. void
+template <class T>
+constexpr std::enable_if_t<std::is_copy_constructible<T>::value,
+                           const any_operations*>
+generic_operations_of()
+{
+    return &any_operations_for<T>::value;
+}
+
+template <class T>
+constexpr std::enable_if_t<!std::is_copy_constructible<T>::value,
+                           const any_operations*>
+generic_operations_of()
+{
+    return nullptr;
+}
+
 } // namespace pointer_detail
 
 namespace serialization_detail
 {
+// unsigned integer type with the given size in bytes, used to write scalars
+// byte by byte regardless of the byte order of the host
+template <std::size_t Size>
+struct unsigned_of_size
+{
+};
+
+template <>
+struct unsigned_of_size<1>
+{
+    typedef std::uint8_t type;
+};
+
+template <>
+struct unsigned_of_size<2>
+{
+    typedef std::uint16_t type;
+};
+
+template <>
+struct unsigned_of_size<4>
+{
+    typedef std::uint32_t type;
+};
+
+template <>
+struct unsigned_of_size<8>
+{
+    typedef std::uint64_t type;
+};
+
+template <class T>
+struct is_fixed_width
+    : std::integral_constant<bool,
+                             sizeof(T) == 1 || sizeof(T) == 2 ||
+                                 sizeof(T) == 4 || sizeof(T) == 8>
+{
+};
+
+
+// append value to buffer least significant byte first
+template <class T>
+std::enable_if_t<is_fixed_width<T>::value>
+write_little_endian(std::vector<char>& buffer, const T& value)
+{
+    typename unsigned_of_size<sizeof(T)>::type bits;
+    std::memcpy(&bits, &value, sizeof(T));
+
+    for(std::size_t i = 0; i < sizeof(T); ++i)
+    {
+        buffer.push_back(static_cast<char>(bits & 0xff));
+        bits = static_cast<decltype(bits)>(bits >> 4 >> 4);
+    }
+}
+
+// integer type values of integer type T are written as, with a width fixed
+// by the type rather than its size on the platform, so eg. long takes 8 bytes
+// on LP64 and LLP64 platforms alike
+template <class T>
+struct wire_integer;
+
+template <>
+struct wire_integer<char>
+{
+    typedef std::conditional_t<std::is_signed<char>::value,
+                               std::int8_t,
+                               std::uint8_t>
+        type;
+};
+
+template <>
+struct wire_integer<signed char>
+{
+    typedef std::int8_t type;
+};
+
+template <>
+struct wire_integer<unsigned char>
+{
+    typedef std::uint8_t type;
+};
+
+template <>
+struct wire_integer<short>
+{
+    typedef std::int16_t type;
+};
+
+template <>
+struct wire_integer<unsigned short>
+{
+    typedef std::uint16_t type;
+};
+
+template <>
+struct wire_integer<int>
+{
+    typedef std::int32_t type;
+};
+
+template <>
+struct wire_integer<unsigned int>
+{
+    typedef std::uint32_t type;
+};
+
+template <>
+struct wire_integer<long>
+{
+    typedef std::int64_t type;
+};
+
+template <>
+struct wire_integer<unsigned long>
+{
+    typedef std::uint64_t type;
+};
+
+template <>
+struct wire_integer<long long>
+{
+    typedef std::int64_t type;
+};
+
+template <>
+struct wire_integer<unsigned long long>
+{
+    typedef std::uint64_t type;
+};
+
+// true if value of integer type From is in the range of integer type To of
+// the same signedness
+template <class To, class From>
+bool
+in_range_of(From value)
+{
+    typedef std::conditional_t<std::is_signed<From>::value,
+                               std::intmax_t,
+                               std::uintmax_t>
+        widest;
+
+    return static_cast<widest>(value) >=
+               static_cast<widest>(std::numeric_limits<To>::min()) &&
+           static_cast<widest>(value) <=
+               static_cast<widest>(std::numeric_limits<To>::max());
+}
+
+// long double has a platform specific size and layout, and carries padding on
+// most platforms, so it is written as a flags byte (bit 0 sign, bit 1 infinity,
+// bit 2 nan), the binary exponent as int32 and the fraction in [0.5, 1)
+// scaled by 2^128 as two uint64, most significant first, all little endian
+enum : unsigned char
+{
+    wide_float_negative = 1,
+    wide_float_infinity = 2,
+    wide_float_nan = 4
+};
+
+template <class T>
+void
+write_wide_float(std::vector<char>& buffer, T value)
+{
+    unsigned char flags = std::signbit(value) ? wide_float_negative : 0;
+    int exponent = 0;
+    std::uint64_t high = 0;
+    std::uint64_t low = 0;
+
+    if(std::isnan(value))
+    {
+        flags |= wide_float_nan;
+    }
+    else if(std::isinf(value))
+    {
+        flags |= wide_float_infinity;
+    }
+    else
+    {
+        const T fraction = std::frexp(std::fabs(value), &exponent);
+
+        // fraction is 0 or in [0.5, 1), so the scaled value fits in 64 bits
+        const T scaled = std::ldexp(fraction, 64);
+        high = static_cast<std::uint64_t>(scaled);
+        low = static_cast<std::uint64_t>(
+            std::ldexp(scaled - static_cast<T>(high), 64));
+    }
+
+    buffer.push_back(static_cast<char>(flags));
+    write_little_endian(buffer, static_cast<std::int32_t>(exponent));
+    write_little_endian(buffer, high);
+    write_little_endian(buffer, low);
+}
+
+// append value of arithmetic type T to buffer, integers with the width of
+// their wire_integer and floating point values with their own
+template <class T>
+std::enable_if_t<std::is_integral<T>::value>
+write_scalar(std::vector<char>& buffer, T value)
+{
+    typedef typename wire_integer<T>::type wire_type;
+
+    if(!in_range_of<wire_type>(value))
+    {
+        throw serialization_error("value too wide for binary format");
+    }
+
+    write_little_endian(buffer, static_cast<wire_type>(value));
+}
+
+template <class T>
+std::enable_if_t<std::is_floating_point<T>::value>
+write_scalar(std::vector<char>& buffer, T value)
+{
+    static_assert(is_fixed_width<T>::value,
+                  "float and double must have 32 and 64 bits");
+    write_little_endian(buffer, value);
+}
+
+inline void
+write_scalar(std::vector<char>& buffer, long double value)
+{
+    write_wide_float(buffer, value);
+}
+
+
+inline void
+check_remaining(const char* first, const char* last, std::size_t size)
+{
+    if(static_cast<std::size_t>(last - first) < size)
+    {
+        throw serialization_error("binary buffer ends before value");
+    }
+}
+
+template <class T>
+std::enable_if_t<is_fixed_width<T>::value, const char*>
+read_little_endian(const char* first, const char* last, T& value)
+{
+    check_remaining(first, last, sizeof(T));
+
+    typename unsigned_of_size<sizeof(T)>::type bits = 0;
+    for(std::size_t i = sizeof(T); i > 0; --i)
+    {
+        bits = static_cast<decltype(bits)>(bits << 4 << 4);
+        bits |= static_cast<unsigned char>(first[i - 1]);
+    }
+
+    std::memcpy(&value, &bits, sizeof(T));
+
+    return first + sizeof(T);
+}
+
+template <class T>
+const char*
+read_wide_float(const char* first, const char* last, T& value)
+{
+    check_remaining(first, last, 1);
+
+    const auto flags = static_cast<unsigned char>(*first);
+    std::int32_t exponent;
+    std::uint64_t high;
+    std::uint64_t low;
+
+    first = read_little_endian(first + 1, last, exponent);
+    first = read_little_endian(first, last, high);
+    first = read_little_endian(first, last, low);
+
+    if(flags & wide_float_nan)
+    {
+        value = std::numeric_limits<T>::quiet_NaN();
+    }
+    else if(flags & wide_float_infinity)
+    {
+        value = std::numeric_limits<T>::infinity();
+    }
+    else
+    {
+        value = std::ldexp(static_cast<T>(high), exponent - 64) +
+                std::ldexp(static_cast<T>(low), exponent - 128);
+    }
+
+    if(flags & wide_float_negative)
+    {
+        value = -value;
+    }
+
+    return first;
+}
+
+
+// read value of arithmetic type T written by write_scalar
+// throws serialization_error if an integer doesn't fit in T
+template <class T>
+std::enable_if_t<std::is_integral<T>::value, const char*>
+read_scalar(const char* first, const char* last, T& value)
+{
+    typename wire_integer<T>::type wire;
+    first = read_little_endian(first, last, wire);
+
+    if(!in_range_of<T>(wire))
+    {
+        throw serialization_error("binary value out of range for type");
+    }
+
+    value = static_cast<T>(wire);
+
+    return first;
+}
+
+template <class T>
+std::enable_if_t<std::is_floating_point<T>::value, const char*>
+read_scalar(const char* first, const char* last, T& value)
+{
+    return read_little_endian(first, last, value);
+}
+
+inline const char*
+read_scalar(const char* first, const char* last, long double& value)
+{
+    return read_wide_float(first, last, value);
+}
 
 
 template <class T, class = void>
@@ -402,6 +1263,34 @@ struct serialization_type_selector<
         in >> value.get<T>();
         return in;
     }
+
+    static void
+    serialize_binary_dispatch(std::vector<char>& buffer, const void* value)
+    {
+        write_scalar(buffer, *static_cast<const T*>(value));
+    }
+
+    static const char*
+    deserialize_binary_dispatch(const char* first,
+                                const char* last,
+                                void* value)
+    {
+        return read_scalar(first, last, *static_cast<T*>(value));
+    }
+
+    static char*
+    write_text_dispatch(char* first, char* last, const void* value)
+    {
+        return text_format::write_arithmetic(
+            first, last, *static_cast<const T*>(value));
+    }
+
+    static const char*
+    read_text_dispatch(const char* first, const char* last, void* value)
+    {
+        return text_format::read_arithmetic(
+            first, last, *static_cast<T*>(value));
+    }
 };
 
 
@@ -424,6 +1313,59 @@ struct serialization_type_selector<std::string>
 
         return in;
     }
+
+    // length as 32 bit unsigned followed by the chars
+    static void
+    serialize_binary_dispatch(std::vector<char>& buffer, const void* value)
+    {
+        const auto& str = *static_cast<const std::string*>(value);
+
+        if(str.size() > std::numeric_limits<std::uint32_t>::max())
+        {
+            throw serialization_error("string too long for binary format");
+        }
+
+        write_little_endian(buffer, static_cast<std::uint32_t>(str.size()));
+        buffer.insert(buffer.end(), str.begin(), str.end());
+    }
+
+    static const char*
+    deserialize_binary_dispatch(const char* first,
+                                const char* last,
+                                void* value)
+    {
+        std::uint32_t size;
+        first = read_little_endian(first, last, size);
+
+        check_remaining(first, last, size);
+        static_cast<std::string*>(value)->assign(first, size);
+
+        return first + size;
+    }
+
+    static char*
+    write_text_dispatch(char* first, char* last, const void* value)
+    {
+        const auto& str = *static_cast<const std::string*>(value);
+
+        if(static_cast<std::size_t>(last - first) < str.size() + 2)
+        {
+            return nullptr;
+        }
+
+        *first++ = '"';
+        first = text_format::write_chars(first, last, str.data(), str.size());
+        *first++ = '"';
+
+        return first;
+    }
+
+    static const char*
+    read_text_dispatch(const char* first, const char* last, void* value)
+    {
+        return text_format::read_string(
+            first, last, *static_cast<std::string*>(value));
+    }
 };
 
 
@@ -463,6 +1405,37 @@ struct serialization_type_selector<bool>
 
         return in;
     }
+
+    static void
+    serialize_binary_dispatch(std::vector<char>& buffer, const void* value)
+    {
+        buffer.push_back(*static_cast<const bool*>(value) ? 1 : 0);
+    }
+
+    static const char*
+    deserialize_binary_dispatch(const char* first,
+                                const char* last,
+                                void* value)
+    {
+        check_remaining(first, last, 1);
+        *static_cast<bool*>(value) = *first != 0;
+
+        return first + 1;
+    }
+
+    static char*
+    write_text_dispatch(char* first, char* last, const void* value)
+    {
+        return *static_cast<const bool*>(value)
+                   ? text_format::write_chars(first, last, "true", 4)
+                   : text_format::write_chars(first, last, "false", 5);
+    }
+
+    static const char*
+    read_text_dispatch(const char* first, const char* last, void* value)
+    {
+        return text_format::read_bool(first, last, *static_cast<bool*>(value));
+    }
 };
 
 
@@ -480,6 +1453,48 @@ generic_deserialization_bind_point(std::istream& in, any& value)
 {
     return serialization_type_selector<T>::deserialize_dispatch(in, value);
 }
+
+
+template <class T>
+void
+generic_binary_serialization_bind_point(std::vector<char>& buffer,
+                                        const void* value)
+{
+    serialization_type_selector<T>::serialize_binary_dispatch(buffer, value);
+}
+
+
+template <class T>
+const char*
+generic_binary_deserialization_bind_point(const char* first,
+                                          const char* last,
+                                          void* value)
+{
+    return serialization_type_selector<T>::deserialize_binary_dispatch(
+        first, last, value);
+}
+
+
+template <class T>
+char*
+generic_text_serialization_bind_point(char* first,
+                                      char* last,
+                                      const void* value)
+{
+    return serialization_type_selector<T>::write_text_dispatch(
+        first, last, value);
+}
+
+
+template <class T>
+const char*
+generic_text_deserialization_bind_point(const char* first,
+                                        const char* last,
+                                        void* value)
+{
+    return serialization_type_selector<T>::read_text_dispatch(
+        first, last, value);
+}
 }
 
 } // namespace shadow
@@ -3,11 +3,14 @@
 
 
 #include <cstddef>
-#include <string>
+#include <cstdint>
+#include <cstring>
 
 #include <type_descriptor.hpp>
 
 #include "reflection_binding.hpp"
+#include "hash_index.hpp"
+#include "string_view.hpp"
 
 
 namespace shadow
@@ -19,12 +22,44 @@ struct type_info
     std::size_t size;
     address_of_signature address_of_bind_point;
     dereference_signature dereference_bind_point;
+    // hash_name(name) computed at compile time, 0 if not available
+    std::uint64_t name_hash;
+    // length of name computed at compile time, 0 if not available
+    std::size_t name_length;
+    // true if values can be copied with memcpy, false if not known
+    bool trivially_copyable;
+    // nullptr if values can't be assigned, or not known
+    assign_signature assign_bind_point;
+    // true if member variables can be addressed by offset, false if not known
+    bool standard_layout;
+    // alignment of values, 0 if not known
+    std::size_t alignment;
+    // copy, move and destroy operations on values, nullptr if values can't be
+    // copied or not known
+    const any_operations* operations;
 };
 
 inline bool
 operator==(const type_info& lhs, const type_info& rhs)
 {
-    return std::string(lhs.name) == std::string(rhs.name);
+    return std::strcmp(lhs.name, rhs.name) == 0;
+}
+
+// hash of the name of the type, computed if not stored in the type_info
+inline std::uint64_t
+name_hash_of(const type_info& info)
+{
+    return info.name_hash != 0 ? info.name_hash : hash_name(info.name);
+}
+
+// view of the name of an info holding a name, measured if the length isn't
+// stored in the info
+template <class InfoType>
+inline string_view
+name_view_of(const InfoType& info)
+{
+    return info.name_length != 0 ? string_view(info.name, info.name_length)
+                                 : string_view(info.name);
 }
 
 typedef metamusil::t_descriptor::type_tag type_attribute;
@@ -76,6 +111,20 @@ struct free_function_info
     const std::size_t* parameter_type_indices;
     const bool* parameter_pointer_flags;
     free_function_binding_signature bind_point;
+    // length of name computed at compile time, 0 if not available
+    std::size_t name_length;
+    // typed trampoline used by reflection_manager::invoke, nullptr if not
+    // available
+    free_function_invoke_signature invoke_bind_point;
+    // flags for parameters the function can write the argument through,
+    // non-const references and pointers to non-const
+    const bool* parameter_writable_flags;
+    // loop over columns of arguments used by the batch calls, nullptr if not
+    // available
+    free_function_batch_signature batch_bind_point;
+    // user supplied kernel taking whole columns, used by the batch calls in
+    // place of batch_bind_point, nullptr if none is registered
+    free_function_batch_signature batch_kernel_bind_point;
 };
 
 inline bool
@@ -94,6 +143,11 @@ struct member_function_info
     const std::size_t* parameter_type_indices;
     const bool* parameter_pointer_flags;
     member_function_binding_signature bind_point;
+    // length of name computed at compile time, 0 if not available
+    std::size_t name_length;
+    // calls the member function on a contiguous array of objects, nullptr if
+    // not available
+    member_function_batch_signature batch_bind_point;
 };
 
 inline bool
@@ -111,6 +165,8 @@ struct member_variable_info
     std::size_t offset;
     member_variable_get_binding_signature get_bind_point;
     member_variable_set_binding_signature set_bind_point;
+    // length of name computed at compile time, 0 if not available
+    std::size_t name_length;
 };
 
 inline bool
@@ -121,12 +177,28 @@ operator==(const member_variable_info& lhs, const member_variable_info& rhs)
 }
 
 
+// layout of a member variable as part of the schema of its class type
+struct schema_field
+{
+    const char* name;
+    std::size_t type_index;
+    std::size_t offset;
+    std::size_t size;
+};
+
+
 struct serialization_info
 {
     const char* name;
     std::size_t type_index;
     serialization_signature serialization_bind_point;
     deserialization_signature deserialization_bind_point;
+    // nullptr if the type has no binary format
+    binary_serialization_signature binary_serialization_bind_point;
+    binary_deserialization_signature binary_deserialization_bind_point;
+    // nullptr if the type can't be written to char buffers
+    text_serialization_signature text_serialization_bind_point;
+    text_deserialization_signature text_deserialization_bind_point;
 };
 
 
@@ -2,14 +2,24 @@
 
 #include <utility>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 #include <algorithm>
+#include <iterator>
 
 #include <array_view.hpp>
 #include "reflection_info.hpp"
 #include "api_types.hpp"
+#include "bound_call.hpp"
 #include "info_iterators.hpp"
 #include "exceptions.hpp"
+#include "hash_index.hpp"
+#include "member_accessor.hpp"
+#include "member_reference.hpp"
+#include "resolution_cache.hpp"
+#include "serialization_plan.hpp"
+#include "string_view.hpp"
+#include "typed_free_function.hpp"
 
 namespace shadow
 {
@@ -41,6 +51,52 @@ struct array_selector<I[N]>
 } // namespace reflection_initialization_detail
 
 
+namespace call_detail
+{
+// number of arguments that are held on the stack when calling constructors and
+// functions through the reflection_manager, calls with more arguments fall
+// back to allocating the argument array on the heap
+constexpr std::size_t max_stack_arguments = 8;
+
+// storage for the array of anys passed to bind points, or of other values
+// kept per argument
+template <std::size_t Capacity, class T = any>
+class argument_array
+{
+public:
+    explicit argument_array(std::size_t size) : size_(size), heap_()
+    {
+        if(size_ > Capacity)
+        {
+            heap_.resize(size_);
+        }
+    }
+
+    T*
+    begin()
+    {
+        return size_ > Capacity ? heap_.data() : stack_;
+    }
+
+    T*
+    end()
+    {
+        return begin() + size_;
+    }
+
+private:
+    std::size_t size_;
+    T stack_[Capacity];
+    std::vector<T> heap_;
+};
+
+typedef argument_array<max_stack_arguments> default_argument_array;
+// type indices of the arguments of a call
+typedef argument_array<max_stack_arguments, std::size_t>
+    default_argument_type_array;
+} // namespace call_detail
+
+
 // point of interaction with the reflection system
 class reflection_manager
 {
@@ -99,8 +155,35 @@ public:
 
     std::string type_name(const type_tag& tag) const;
 
+    // the *_name_view functions return names without allocating, the views
+    // refer to static storage and stay valid for the life of the program
+    string_view type_name_view(const type_tag& tag) const;
+
     std::size_t type_size(const type_tag& tag) const;
 
+    std::size_t type_alignment(const type_tag& tag) const;
+
+    // true if values of the type can be copied as bytes, ie. with memcpy
+    bool type_is_trivially_copyable(const type_tag& tag) const;
+
+    // true if member variables of the type can be addressed by their offset
+    bool type_is_standard_layout(const type_tag& tag) const;
+
+    // true if tag is the type T, ie. its values can be accessed as T
+    template <class T>
+    bool type_is(const type_tag& tag) const;
+
+    // layout of the registered member variables of the type, in order of
+    // offset
+    std::pair<const schema_field*, const schema_field*>
+    type_schema(const type_tag& tag) const;
+
+    // 64 bit hash of the name and size of the type and its schema, including
+    // the schemas of the types of its member variables
+    // it depends only on names, sizes and offsets, so it is the same across
+    // processes registering the same types with the same layout
+    std::uint64_t type_schema_hash(const type_tag& tag) const;
+
 
     // returns range of all constructors available
     std::pair<const_constructor_iterator, const_constructor_iterator>
@@ -148,6 +231,8 @@ public:
     // returns name of function associated with the free_function_tag
     std::string free_function_name(const free_function_tag& tag) const;
 
+    string_view free_function_name_view(const free_function_tag& tag) const;
+
     // returns return type of function associated with the free_function_tag
     type_tag free_function_return_type(const free_function_tag& tag) const;
 
@@ -163,6 +248,84 @@ public:
 
     object call_free_function(const free_function_tag& tag) const;
 
+    // returns iterator to the free function with the given name, or
+    // free_functions().second if there is none
+    // if several functions share the name, the first registered is found
+    const_free_function_iterator find_free_function(string_view name) const;
+
+    // call the free function with the given name whose parameter types match
+    // the types of the arguments in the range first -> last
+    // the resolution is cached, so later calls with the same name and argument
+    // types don't search the free functions again. Throws argument_error if no
+    // function matches.
+    template <class Iterator>
+    object call_free_function(string_view name,
+                              Iterator first,
+                              Iterator last) const;
+
+    // call free function with arguments of types known at compile time,
+    // passing them to its typed trampoline without boxing them in objects
+    // args, without references, cv-qualifiers and pointers, must have the
+    // parameter types of the function, and be non-const lvalues or pointers to
+    // non-const for parameters taking non-const references or pointers,
+    // otherwise argument_error is thrown.
+    // Throws type_error if ReturnType isn't the return type of the function.
+    template <class ReturnType, class... Args>
+    ReturnType invoke(const free_function_tag& tag, Args&&... args) const;
+
+    // as invoke, but checks the signature once when the handle is made
+    // rather than on every call, eg. for int f(int, const std::string&):
+    //     auto f = manager.free_function_handle<int(int, std::string)>(tag);
+    //     int result = f(1, "a");
+    template <class Signature>
+    typed_free_function<Signature>
+    free_function_handle(const free_function_tag& tag) const;
+
+    // true if a batch kernel was registered for the free function with
+    // REGISTER_FREE_FUNCTION_WITH_BATCH_KERNEL, which the batch calls then use
+    // instead of calling the function once per row
+    bool free_function_has_batch_kernel(const free_function_tag& tag) const;
+
+    // call the free function once per row of the argument columns, each an
+    // array of rows values of the type of the corresponding parameter, and
+    // assign the return value of each row to the same row of results, which
+    // must hold rows values, or be nullptr for functions returning void
+    // the types are checked once and the rows are then run in a loop generated
+    // at registration. Columns of non-const reference or pointer parameters
+    // are modified by the function.
+    // Throws argument_error if the columns don't match the parameter types or
+    // are const for such parameters, and type_error if ReturnType isn't the
+    // return type.
+    template <class ReturnType, class... Columns>
+    void invoke_batch(const free_function_tag& tag,
+                      std::size_t rows,
+                      ReturnType* results,
+                      Columns*... columns) const;
+
+    // as invoke_batch, with the argument columns held by the object_vectors
+    // pointed to by the range first -> last, and the return values assigned
+    // to results, which must hold as many values as each column
+    // throws argument_error if the columns don't match the parameter types or
+    // the size of results, and type_error if results isn't of the return type
+    void call_free_function_batch(const free_function_tag& tag,
+                                  object_vector* const* first,
+                                  object_vector* const* last,
+                                  object_vector& results) const;
+
+    // as above, for free functions returning void
+    // throws type_error if the function returns a value
+    void call_free_function_batch(const free_function_tag& tag,
+                                  object_vector* const* first,
+                                  object_vector* const* last) const;
+
+    // call of the free function with the objects in the range first -> last
+    // copied into its argument slots, to be refilled and called repeatedly
+    // throws argument_error if the objects don't match the parameter types
+    template <class Iterator>
+    bound_call bind_call(const free_function_tag& tag,
+                         Iterator first,
+                         Iterator last) const;
+
 
     // return all available member functions
     std::pair<const_member_function_iterator, const_member_function_iterator>
@@ -176,6 +339,9 @@ public:
 
     std::string member_function_name(const member_function_tag& tag) const;
 
+    string_view
+    member_function_name_view(const member_function_tag& tag) const;
+
     std::pair<const_indexed_type_iterator, const_indexed_type_iterator>
     member_function_parameter_types(const member_function_tag& tag) const;
 
@@ -188,6 +354,40 @@ public:
     object call_member_function(object& obj,
                                 const member_function_tag& tag) const;
 
+    // call the member function with the arguments in the range first -> last
+    // on each value held by objects, checking the arguments and the class type
+    // once for all of them rather than per object
+    // throws argument_error if the arguments don't match the parameters, and
+    // type_error if objects doesn't hold the class of the member function
+    template <class Iterator>
+    void call_member_function_batch(object_vector& objects,
+                                    const member_function_tag& tag,
+                                    Iterator first,
+                                    Iterator last) const;
+
+    // as above, with the return value for each value of objects assigned to
+    // the value at the same index of results
+    // also throws type_error if results doesn't hold the return type, and
+    // argument_error if it isn't the size of objects
+    template <class Iterator>
+    void call_member_function_batch(object_vector& objects,
+                                    const member_function_tag& tag,
+                                    Iterator first,
+                                    Iterator last,
+                                    object_vector& results) const;
+
+    // as bind_call for free functions, the object to call the member function
+    // on is passed to bound_call::call
+    template <class Iterator>
+    bound_call bind_call(const member_function_tag& tag,
+                         Iterator first,
+                         Iterator last) const;
+
+    // returns iterator to the member function of the given class type with the
+    // given name, or member_functions().second if there is none
+    const_member_function_iterator
+    find_member_function(const type_tag& tag, string_view name) const;
+
 
     std::pair<const_member_variable_iterator, const_member_variable_iterator>
     member_variables() const;
@@ -200,8 +400,14 @@ public:
 
     type_tag member_variable_class_type(const member_variable_tag& tag) const;
 
+    // offset in bytes of the member variable within its class
+    std::size_t member_variable_offset(const member_variable_tag& tag) const;
+
     std::string member_variable_name(const member_variable_tag& tag) const;
 
+    string_view
+    member_variable_name_view(const member_variable_tag& tag) const;
+
     void set_member_variable(object& obj,
                              const member_variable_tag& tag,
                              const object& val) const;
@@ -209,6 +415,91 @@ public:
     object get_member_variable(const object& obj,
                                const member_variable_tag& tag) const;
 
+    // reference to the member variable within the value held by obj, for
+    // reading and writing it in place without copying through an object
+    // throws type_error if the member variable doesn't belong to the type of
+    // obj, or if the class isn't standard layout
+    member_reference
+    member_variable_reference(object& obj,
+                              const member_variable_tag& tag) const;
+
+    const_member_reference
+    member_variable_reference(const object& obj,
+                              const member_variable_tag& tag) const;
+
+    // assign the value held by val to the referenced member variable
+    // throws type_error if val holds a value of another type, or if the type
+    // can't be assigned
+    void set_member_reference(const member_reference& ref,
+                              const object& val) const;
+
+    // accessor reading and writing the member variable as a T directly at its
+    // offset, for repeated access to the same member of many objects
+    // throws type_error if the class of the member variable isn't standard
+    // layout, or if T isn't the type of the member variable
+    template <class T>
+    member_accessor<T>
+    member_variable_accessor(const member_variable_tag& tag) const;
+
+    // returns iterator to the member variable of the given class type with the
+    // given name, or member_variables().second if there is none
+    const_member_variable_iterator
+    find_member_variable(const type_tag& tag, string_view name) const;
+
+
+    // append binary representation of obj to buffer
+    // scalars are written with fixed width in little endian byte order,
+    // strings as their length in 32 bits followed by the chars, and other
+    // types as their registered member variables in order of offset
+    // throws serialization_error if such a type isn't standard layout, as the
+    // member variables are read at their offsets
+    void serialize_binary(const object& obj, std::vector<char>& buffer) const;
+
+    // read binary representation of a value of the type held by obj from the
+    // range first -> last into obj, returns pointer past the bytes read
+    // throws serialization_error if the range ends before the value
+    const char*
+    deserialize_binary(object& obj, const char* first, const char* last) const;
+
+    // append binary representation of all objects in the range first -> last
+    // to buffer, one after another
+    // the objects must hold the same type, they are serialized with a plan
+    // of the type's flattened member variables made once per type
+    // throws type_error if the types differ
+    template <class Iterator>
+    void serialize_binary(Iterator first,
+                          Iterator last,
+                          std::vector<char>& buffer) const;
+
+
+    // append text representation of obj to buffer, in the same format as
+    // operator<< but without going through std::ostream
+    // floating point values are written with the fewest digits that read back
+    // to the same value
+    void serialize_text(const object& obj, std::vector<char>& buffer) const;
+
+    // write text representation of obj to the range first -> last, returns
+    // pointer past the text written
+    // throws serialization_error if the text doesn't fit
+    char* serialize_text(const object& obj, char* first, char* last) const;
+
+    // append text representation of all objects in the range first -> last to
+    // buffer, each followed by a newline
+    // as for serialize_binary, the objects must hold the same type
+    template <class Iterator>
+    void serialize_text(Iterator first,
+                        Iterator last,
+                        std::vector<char>& buffer) const;
+
+    // parse text in the format written by operator<< from the range
+    // first -> last into obj in a single pass, returns pointer past the text
+    // parsed
+    // member variables are parsed in place, without copying them out of and
+    // back into the object. Throws serialization_error if the text is
+    // malformed, or if a type with member variables isn't standard layout.
+    const char*
+    deserialize_text(object& obj, const char* first, const char* last) const;
+
 public:
     // unchecked operations
     template <class T>
@@ -227,6 +518,61 @@ private:
 
     bool compare_type(const type_tag& tag, std::size_t index) const;
 
+    // throws unless the free function has return type ReturnType and
+    // parameters matching Args, as deduced for forwarding references
+    template <class ReturnType, class... Args>
+    void check_invoke_signature(const free_function_info& info) const;
+
+    // unpacks the signature of a typed_free_function for
+    // check_invoke_signature
+    template <class ReturnType, class... ParamTypes>
+    void
+    check_handle_signature(typed_free_function<ReturnType(ParamTypes...)>*,
+                           const free_function_info& info) const;
+
+    template <class... Args, std::size_t... ArgSeq>
+    bool invoke_arguments_match(const free_function_info& info,
+                                std::index_sequence<ArgSeq...>) const;
+
+    // as invoke_arguments_match, but for columns holding the values pointer
+    // parameters point to
+    template <class... Columns, std::size_t... ColumnSeq>
+    bool batch_columns_match(const free_function_info& info,
+                             std::index_sequence<ColumnSeq...>) const;
+
+    // check objects and results and run batch_bind_point of info over them,
+    // results is nullptr to discard the return values
+    void run_member_batch(const member_function_info& info,
+                          object_vector& objects,
+                          any* argument_array,
+                          object_vector* results) const;
+
+    // registered batch kernel of info if any, otherwise its generated loop
+    static free_function_batch_signature
+    batch_bind_point_of(const free_function_info& info);
+
+    // check columns and run the batch bind point of info over them
+    void run_batch(const free_function_info& info,
+                   object_vector* const* first,
+                   object_vector* const* last,
+                   std::size_t rows,
+                   void* results) const;
+
+    // true if a value of type T, or pointer to one if is_pointer is set, has
+    // the type at index
+    template <class T>
+    bool invoke_argument_matches(std::size_t index, bool is_pointer) const;
+
+    // true if obj holds a value of the type at index in type_info_view_
+    bool object_has_type(const object& obj, std::size_t index) const;
+
+    // true if info describes T
+    // types are identified by their any operations, as any::has_type does.
+    // void is the only registered type without them, other types without them
+    // can't be registered and match nothing.
+    template <class T>
+    static bool type_info_is(const type_info& info);
+
     template <class Iterator, class OutputIterator, class InfoType>
     void construct_argument_array(Iterator first,
                                   Iterator last,
@@ -246,9 +592,72 @@ private:
                     std::size_t num_types,
                     InfoExtractor&& extract_info) const;
 
+    // call through bind point without checking the arguments
+    template <class Iterator>
+    object invoke_free_function(const free_function_info& info,
+                                Iterator first,
+                                Iterator last) const;
+
+    // key of resolution_cache for call with name and arguments of the types
+    // at the indices first -> last
+    std::uint64_t resolution_key(string_view name,
+                                 const std::size_t* first,
+                                 const std::size_t* last) const;
+
+    // flattened leaf values of the type at type_index, built on first use
+    const serialization_plan& plan_for(std::size_t type_index) const;
+    serialization_plan make_plan(std::size_t type_index) const;
+    void append_steps(std::size_t type_index,
+                      std::size_t offset,
+                      std::string& prefix,
+                      serialization_plan& plan) const;
+
+    void write_binary(const serialization_plan& plan,
+                      const void* value,
+                      std::vector<char>& buffer) const;
+
+    const char* read_binary(const serialization_plan& plan,
+                            void* value,
+                            const char* first,
+                            const char* last) const;
+
+    // returns nullptr if the text doesn't fit in first -> last
+    char* write_text(const serialization_plan& plan,
+                     const void* value,
+                     char* first,
+                     char* last) const;
+
+    // write text of value at position of buffer, which is grown only when the
+    // text doesn't fit, returns position past the text
+    // the caller shrinks buffer to the end of the text once done writing
+    std::size_t append_text(const serialization_plan& plan,
+                            const void* value,
+                            std::vector<char>& buffer,
+                            std::size_t position) const;
+
+    const char* read_text(std::size_t type_index,
+                          void* value,
+                          const char* first,
+                          const char* last) const;
+
+    hash_index index_type_names() const;
+    std::vector<std::vector<schema_field>> schemas() const;
+    std::vector<std::uint64_t> schema_hashes() const;
+    std::uint64_t schema_hash(std::size_t type_index,
+                              std::vector<std::uint64_t>& hashes,
+                              std::vector<bool>& done) const;
+    std::vector<const serialization_info*> default_serializations() const;
+    hash_index index_free_function_names() const;
+    hash_index index_member_function_names() const;
+    hash_index index_member_variable_names() const;
+
     std::size_t index_of_type(const type_tag& tag) const;
     std::size_t index_of_object(const object& obj) const;
 
+    // as above, but return hash_index::npos for unregistered types
+    std::size_t find_index_of_type(const type_tag& tag) const;
+    std::size_t find_index_of_object(const object& obj) const;
+
 private:
     // array_views of reflection information generated at compile time
     helene::array_view<const type_info> type_info_view_;
@@ -263,6 +672,29 @@ private:
     std::vector<std::vector<std::size_t>> conversion_indices_by_type_;
     std::vector<std::vector<std::size_t>> member_function_indices_by_type_;
     std::vector<std::vector<std::size_t>> member_variable_indices_by_type_;
+
+    // "default" serialization_info by type index, nullptr for types without
+    std::vector<const serialization_info*> default_serialization_by_type_;
+
+    // schema and schema hash by type index
+    std::vector<std::vector<schema_field>> schemas_by_type_;
+    std::vector<std::uint64_t> schema_hashes_by_type_;
+
+    // indices into type_info_view_ by hash of type name
+    hash_index type_indices_by_name_;
+
+    // indices into the function and variable views by hash of name, combined
+    // with the index of the class type for members
+    hash_index free_function_indices_by_name_;
+    hash_index member_function_indices_by_name_;
+    hash_index member_variable_indices_by_name_;
+
+    // indices into free_function_info_view_ by name and argument types of
+    // calls made through call_free_function(name, first, last)
+    mutable resolution_cache free_function_resolutions_;
+
+    // flattened serialization of types by type index
+    serialization_plan_cache serialization_plans_;
 };
 } // namespace shadow
 
@@ -321,7 +753,16 @@ inline reflection_manager::reflection_manager(TypeInfoArray& ti_arr,
                           type_info_view_.size(),
                           [](const member_variable_info& info) {
                               return info.object_type_index;
-                          }))
+                          })),
+      default_serialization_by_type_(default_serializations()),
+      schemas_by_type_(schemas()),
+      schema_hashes_by_type_(schema_hashes()),
+      type_indices_by_name_(index_type_names()),
+      free_function_indices_by_name_(index_free_function_names()),
+      member_function_indices_by_name_(index_member_function_names()),
+      member_variable_indices_by_name_(index_member_variable_names()),
+      free_function_resolutions_(),
+      serialization_plans_()
 {
     // sort member variables by offset
     std::for_each(member_variable_indices_by_type_.begin(),
@@ -343,7 +784,8 @@ reflection_manager::check_arguments(Iterator first,
                                     Iterator last,
                                     const InfoType& info) const
 {
-    if(info.num_parameters != std::distance(first, last))
+    if(info.num_parameters !=
+       static_cast<std::size_t>(std::distance(first, last)))
     {
         return false;
     }
@@ -351,7 +793,7 @@ reflection_manager::check_arguments(Iterator first,
     for(auto index_ptr = info.parameter_type_indices; first != last;
         ++index_ptr, ++first)
     {
-        if(compare_type(first->type(), *index_ptr) == false)
+        if(object_has_type(*first, *index_ptr) == false)
         {
             return false;
         }
@@ -361,6 +803,20 @@ reflection_manager::check_arguments(Iterator first,
 }
 
 
+inline bool
+reflection_manager::object_has_type(const object& obj, std::size_t index) const
+{
+    // objects from this manager point into type_info_view_, so no need to
+    // compare names
+    if(obj.manager_ == this)
+    {
+        return obj.type_info_ == type_info_view_.data() + index;
+    }
+
+    return compare_type(obj.type(), index);
+}
+
+
 template <class InfoType>
 inline bool
 reflection_manager::check_member_class_type(const object& obj,
@@ -385,11 +841,11 @@ reflection_manager::construct_argument_array(Iterator first,
             // construct any with pointer to value
             auto address_bind_point = first->type_info_->address_of_bind_point;
 
-            out = address_bind_point(first->value_);
+            *out = address_bind_point(first->value_);
         }
         else
         {
-            out = first->value_;
+            *out = first->value_;
         }
     }
 }
@@ -451,18 +907,38 @@ reflection_manager::construct_object(const constructor_tag& tag,
         throw argument_error("wrong argument types");
     }
 
-    std::vector<any> arg_vec;
-    arg_vec.reserve(std::distance(first, last));
+    call_detail::default_argument_array args(std::distance(first, last));
 
-    construct_argument_array(
-        first, last, std::back_inserter(arg_vec), *tag.info_ptr_);
+    construct_argument_array(first, last, args.begin(), *tag.info_ptr_);
 
-    auto return_value = tag.info_ptr_->bind_point(arg_vec.data());
+    auto return_value = tag.info_ptr_->bind_point(args.begin());
 
     return object(
         return_value, type_info_view_.data() + tag.info_ptr_->type_index, this);
 }
 
+template <class T>
+inline bool
+reflection_manager::type_is(const type_tag& tag) const
+{
+    return type_info_is<T>(*tag.info_ptr_);
+}
+
+template <class T>
+inline bool
+reflection_manager::type_info_is(const type_info& info)
+{
+    const auto operations = pointer_detail::generic_operations_of<T>();
+
+    if(operations == nullptr)
+    {
+        return std::is_void<T>::value && info.operations == nullptr;
+    }
+
+    return info.operations == operations;
+}
+
+
 template <class T>
 inline T&
 reflection_manager::get(object& obj) const
@@ -478,6 +954,29 @@ reflection_manager::get(const object& obj) const
 }
 
 
+template <class T>
+inline member_accessor<T>
+reflection_manager::member_variable_accessor(
+    const member_variable_tag& tag) const
+{
+    const auto& class_info = type_info_view_[tag.info_ptr_->object_type_index];
+
+    if(!class_info.standard_layout)
+    {
+        throw type_error(
+            "member variables can only be accessed by offset in standard "
+            "layout classes");
+    }
+
+    if(!type_info_is<T>(type_info_view_[tag.info_ptr_->type_index]))
+    {
+        throw type_error("accessor type doesn't match member variable type");
+    }
+
+    return member_accessor<T>(tag.info_ptr_->offset);
+}
+
+
 template <class Iterator>
 inline object
 reflection_manager::call_free_function(const free_function_tag& tag,
@@ -490,19 +989,274 @@ reflection_manager::call_free_function(const free_function_tag& tag,
             "attempting to call free function with arguments of wrong type");
     }
 
-    std::vector<shadow::any> args;
-    args.reserve(std::distance(first, last));
+    return invoke_free_function(*tag.info_ptr_, first, last);
+}
+
+
+template <class Iterator>
+inline object
+reflection_manager::call_free_function(string_view name,
+                                       Iterator first,
+                                       Iterator last) const
+{
+    call_detail::default_argument_type_array types(std::distance(first, last));
+
+    auto type_ptr = types.begin();
+    for(auto arg = first; arg != last; ++arg, ++type_ptr)
+    {
+        *type_ptr = find_index_of_object(*arg);
+
+        // no function takes arguments of unregistered types
+        if(*type_ptr == hash_index::npos)
+        {
+            throw argument_error(
+                "no free function with matching name and argument types");
+        }
+    }
+
+    const auto key = resolution_key(name, types.begin(), types.end());
 
-    construct_argument_array(
-        first, last, std::back_inserter(args), *tag.info_ptr_);
+    // the cache compares the argument types, only names with colliding
+    // hashes remain to be told apart
+    const auto cached =
+        free_function_resolutions_.find(key, types.begin(), types.end());
+    if(cached != hash_index::npos &&
+       name == name_view_of(free_function_info_view_[cached]))
+    {
+        return invoke_free_function(
+            free_function_info_view_[cached], first, last);
+    }
 
-    auto return_value = tag.info_ptr_->bind_point(args.data());
+    for(std::size_t index = 0; index < free_function_info_view_.size();
+        ++index)
+    {
+        const auto& info = free_function_info_view_[index];
+        if(name == name_view_of(info) &&
+           info.num_parameters ==
+               static_cast<std::size_t>(std::distance(first, last)) &&
+           std::equal(types.begin(), types.end(), info.parameter_type_indices))
+        {
+            free_function_resolutions_.insert(
+                key, types.begin(), types.end(), index);
 
-    pass_parameters_out(args.begin(), args.end(), first, *tag.info_ptr_);
+            return invoke_free_function(info, first, last);
+        }
+    }
 
-    return object(return_value,
-                  type_info_view_.data() + tag.info_ptr_->return_type_index,
-                  this);
+    throw argument_error(
+        "no free function with matching name and argument types");
+}
+
+
+template <class ReturnType, class... Args>
+inline ReturnType
+reflection_manager::invoke(const free_function_tag& tag, Args&&... args) const
+{
+    check_invoke_signature<ReturnType, Args...>(*tag.info_ptr_);
+
+    return invoke_detail::caller<ReturnType>::call(
+        tag.info_ptr_->invoke_bind_point,
+        invoke_detail::pass_argument(args)...);
+}
+
+
+template <class Signature>
+inline typed_free_function<Signature>
+reflection_manager::free_function_handle(const free_function_tag& tag) const
+{
+    check_handle_signature(
+        static_cast<typed_free_function<Signature>*>(nullptr), *tag.info_ptr_);
+
+    return typed_free_function<Signature>(tag.info_ptr_->invoke_bind_point);
+}
+
+
+template <class Iterator>
+inline bound_call
+reflection_manager::bind_call(const free_function_tag& tag,
+                              Iterator first,
+                              Iterator last) const
+{
+    if(!check_arguments(first, last, *tag.info_ptr_))
+    {
+        throw argument_error(
+            "attempting to bind free function to arguments of wrong type");
+    }
+
+    return bound_call(this,
+                      tag.info_ptr_->bind_point,
+                      nullptr,
+                      nullptr,
+                      type_info_view_.data() + tag.info_ptr_->return_type_index,
+                      type_info_view_.data(),
+                      tag.info_ptr_->parameter_type_indices,
+                      tag.info_ptr_->parameter_pointer_flags,
+                      first,
+                      last);
+}
+
+template <class Iterator>
+inline bound_call
+reflection_manager::bind_call(const member_function_tag& tag,
+                              Iterator first,
+                              Iterator last) const
+{
+    if(!check_arguments(first, last, *tag.info_ptr_))
+    {
+        throw argument_error(
+            "attempting to bind member function to arguments of wrong type");
+    }
+
+    return bound_call(this,
+                      nullptr,
+                      tag.info_ptr_->bind_point,
+                      type_info_view_.data() + tag.info_ptr_->object_type_index,
+                      type_info_view_.data() + tag.info_ptr_->return_type_index,
+                      type_info_view_.data(),
+                      tag.info_ptr_->parameter_type_indices,
+                      tag.info_ptr_->parameter_pointer_flags,
+                      first,
+                      last);
+}
+
+
+template <class ReturnType, class... Args>
+inline void
+reflection_manager::check_invoke_signature(const free_function_info& info) const
+{
+    if(info.invoke_bind_point == nullptr)
+    {
+        throw argument_error("free function has no typed trampoline");
+    }
+
+    if(sizeof...(Args) != info.num_parameters)
+    {
+        throw argument_error("wrong number of arguments");
+    }
+
+    if(!invoke_arguments_match<Args...>(info,
+                                        std::index_sequence_for<Args...>()))
+    {
+        throw argument_error("wrong argument types");
+    }
+
+    if(!type_info_is<ReturnType>(type_info_view_[info.return_type_index]))
+    {
+        throw type_error("wrong return type");
+    }
+}
+
+
+template <class ReturnType, class... Columns>
+inline void
+reflection_manager::invoke_batch(const free_function_tag& tag,
+                                 std::size_t rows,
+                                 ReturnType* results,
+                                 Columns*... columns) const
+{
+    const auto& info = *tag.info_ptr_;
+    const auto batch_bind_point = batch_bind_point_of(info);
+
+    if(batch_bind_point == nullptr)
+    {
+        throw argument_error("free function has no batch trampoline");
+    }
+
+    if(sizeof...(Columns) != info.num_parameters)
+    {
+        throw argument_error("wrong number of argument columns");
+    }
+
+    if(!batch_columns_match<Columns...>(info,
+                                        std::index_sequence_for<Columns...>()))
+    {
+        throw argument_error("wrong argument column types");
+    }
+
+    if(!type_info_is<ReturnType>(type_info_view_[info.return_type_index]))
+    {
+        throw type_error("wrong return type");
+    }
+
+    // trailing nullptr avoids an empty array for functions without parameters
+    void* const column_array[] = {
+        const_cast<void*>(static_cast<const void*>(columns))..., nullptr};
+
+    batch_bind_point(results, column_array, rows);
+}
+
+
+template <class ReturnType, class... ParamTypes>
+inline void
+reflection_manager::check_handle_signature(
+    typed_free_function<ReturnType(ParamTypes...)>*,
+    const free_function_info& info) const
+{
+    check_invoke_signature<ReturnType, ParamTypes...>(info);
+}
+
+
+template <class... Args, std::size_t... ArgSeq>
+inline bool
+reflection_manager::invoke_arguments_match(
+    const free_function_info& info, std::index_sequence<ArgSeq...>) const
+{
+    const bool matches[] = {
+        true,
+        (invoke_argument_matches<std::decay_t<Args>>(
+             info.parameter_type_indices[ArgSeq],
+             info.parameter_pointer_flags[ArgSeq]) &&
+         (!info.parameter_writable_flags[ArgSeq] ||
+          invoke_detail::is_writable_argument<Args>::value))...};
+
+    return std::find(std::begin(matches), std::end(matches), false) ==
+           std::end(matches);
+}
+
+template <class... Columns, std::size_t... ColumnSeq>
+inline bool
+reflection_manager::batch_columns_match(
+    const free_function_info& info, std::index_sequence<ColumnSeq...>) const
+{
+    // columns hold values, so pointer flags aren't compared, and const
+    // columns can't be given to parameters that write through their argument
+    const bool matches[] = {
+        true,
+        (invoke_argument_matches<std::remove_const_t<Columns>>(
+             info.parameter_type_indices[ColumnSeq], false) &&
+         (!info.parameter_writable_flags[ColumnSeq] ||
+          !std::is_const<Columns>::value))...};
+
+    return std::find(std::begin(matches), std::end(matches), false) ==
+           std::end(matches);
+}
+
+template <class T>
+inline bool
+reflection_manager::invoke_argument_matches(std::size_t index,
+                                            bool is_pointer) const
+{
+    return is_pointer == std::is_pointer<T>::value &&
+           type_info_is<metamusil::base_t<T>>(type_info_view_[index]);
+}
+
+
+template <class Iterator>
+inline object
+reflection_manager::invoke_free_function(const free_function_info& info,
+                                         Iterator first,
+                                         Iterator last) const
+{
+    call_detail::default_argument_array args(std::distance(first, last));
+
+    construct_argument_array(first, last, args.begin(), info);
+
+    auto return_value = info.bind_point(args.begin());
+
+    pass_parameters_out(args.begin(), args.end(), first, info);
+
+    return object(
+        return_value, type_info_view_.data() + info.return_type_index, this);
 }
 
 
@@ -519,13 +1273,11 @@ reflection_manager::call_member_function(object& obj,
             "attempting to call member function with arguments of wrong type");
     }
 
-    std::vector<shadow::any> args;
-    args.reserve(std::distance(first, last));
+    call_detail::default_argument_array args(std::distance(first, last));
 
-    construct_argument_array(
-        first, last, std::back_inserter(args), *tag.info_ptr_);
+    construct_argument_array(first, last, args.begin(), *tag.info_ptr_);
 
-    auto return_value = tag.info_ptr_->bind_point(obj.value_, args.data());
+    auto return_value = tag.info_ptr_->bind_point(obj.value_, args.begin());
 
     pass_parameters_out(args.begin(), args.end(), first, *tag.info_ptr_);
 
@@ -533,4 +1285,129 @@ reflection_manager::call_member_function(object& obj,
                   type_info_view_.data() + tag.info_ptr_->return_type_index,
                   this);
 }
+
+
+template <class Iterator>
+inline void
+reflection_manager::call_member_function_batch(object_vector& objects,
+                                               const member_function_tag& tag,
+                                               Iterator first,
+                                               Iterator last) const
+{
+    if(!check_arguments(first, last, *tag.info_ptr_))
+    {
+        throw argument_error(
+            "attempting to call member function with arguments of wrong type");
+    }
+
+    call_detail::default_argument_array args(std::distance(first, last));
+
+    construct_argument_array(first, last, args.begin(), *tag.info_ptr_);
+
+    run_member_batch(*tag.info_ptr_, objects, args.begin(), nullptr);
+
+    pass_parameters_out(args.begin(), args.end(), first, *tag.info_ptr_);
+}
+
+
+template <class Iterator>
+inline void
+reflection_manager::call_member_function_batch(object_vector& objects,
+                                               const member_function_tag& tag,
+                                               Iterator first,
+                                               Iterator last,
+                                               object_vector& results) const
+{
+    if(!check_arguments(first, last, *tag.info_ptr_))
+    {
+        throw argument_error(
+            "attempting to call member function with arguments of wrong type");
+    }
+
+    call_detail::default_argument_array args(std::distance(first, last));
+
+    construct_argument_array(first, last, args.begin(), *tag.info_ptr_);
+
+    run_member_batch(*tag.info_ptr_, objects, args.begin(), &results);
+
+    pass_parameters_out(args.begin(), args.end(), first, *tag.info_ptr_);
+}
+
+
+template <class Iterator>
+inline void
+reflection_manager::serialize_binary(Iterator first,
+                                     Iterator last,
+                                     std::vector<char>& buffer) const
+{
+    if(first == last)
+    {
+        return;
+    }
+
+    const auto type_index = index_of_object(*first);
+    const auto& plan = plan_for(type_index);
+
+    for(; first != last; ++first)
+    {
+        if(!object_has_type(*first, type_index))
+        {
+            throw type_error("objects serialized together differ in type");
+        }
+
+        write_binary(plan, first->value_.data(), buffer);
+    }
+}
+
+
+template <class Iterator>
+inline void
+reflection_manager::serialize_text(Iterator first,
+                                   Iterator last,
+                                   std::vector<char>& buffer) const
+{
+    if(first == last)
+    {
+        return;
+    }
+
+    const auto type_index = index_of_object(*first);
+    const auto& plan = plan_for(type_index);
+
+    // the buffer is only shrunk to the end of the text once all objects are
+    // written, so its spare room is reused from one object to the next
+    auto position = buffer.size();
+
+    try
+    {
+        for(; first != last; ++first)
+        {
+            if(!object_has_type(*first, type_index))
+            {
+                throw type_error("objects serialized together differ in type");
+            }
+
+            position =
+                append_text(plan, first->value_.data(), buffer, position);
+
+            if(position == buffer.size())
+            {
+                buffer.push_back('\n');
+            }
+            else
+            {
+                buffer[position] = '\n';
+            }
+
+            ++position;
+        }
+    }
+    catch(...)
+    {
+        buffer.resize(position);
+        throw;
+    }
+
+    buffer.resize(position);
+}
 } // namespace shadow
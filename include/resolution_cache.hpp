@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "hash_index.hpp"
+
+
+namespace shadow
+{
+// thread safe map from a key describing a call, ie. hash of name and argument
+// types, together with the argument types, to the index of the function it
+// resolved to
+// lookups only take a shared lock, so any number of threads calling through a
+// const reflection_manager can read concurrently. Argument types are compared
+// exactly, the caller only has to tell apart names with colliding keys.
+class resolution_cache
+{
+public:
+    resolution_cache() : mutex_(), entries_()
+    {
+    }
+
+    // resolutions are not shared between copies
+    resolution_cache(const resolution_cache&) : mutex_(), entries_()
+    {
+    }
+
+    resolution_cache&
+    operator=(const resolution_cache& other)
+    {
+        if(this != &other)
+        {
+            clear();
+        }
+
+        return *this;
+    }
+
+    // returns index stored for key and the argument type indices first ->
+    // last, or hash_index::npos if there is none
+    std::size_t
+    find(std::uint64_t key,
+         const std::size_t* first,
+         const std::size_t* last) const
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+
+        const auto range = entries_.equal_range(key);
+
+        for(auto it = range.first; it != range.second; ++it)
+        {
+            if(it->second.matches(first, last))
+            {
+                return it->second.index;
+            }
+        }
+
+        return hash_index::npos;
+    }
+
+    // store index for key and the argument type indices first -> last,
+    // replacing any previous entry
+    void
+    insert(std::uint64_t key,
+           const std::size_t* first,
+           const std::size_t* last,
+           std::size_t index)
+    {
+        std::lock_guard<std::shared_timed_mutex> lock(mutex_);
+
+        const auto range = entries_.equal_range(key);
+
+        for(auto it = range.first; it != range.second; ++it)
+        {
+            if(it->second.matches(first, last))
+            {
+                it->second.index = index;
+                return;
+            }
+        }
+
+        entries_.emplace(
+            key, entry{std::vector<std::size_t>(first, last), index});
+    }
+
+    void
+    clear()
+    {
+        std::lock_guard<std::shared_timed_mutex> lock(mutex_);
+
+        entries_.clear();
+    }
+
+private:
+    struct entry
+    {
+        bool
+        matches(const std::size_t* first, const std::size_t* last) const
+        {
+            return argument_types.size() ==
+                       static_cast<std::size_t>(last - first) &&
+                   std::equal(first, last, argument_types.begin());
+        }
+
+        std::vector<std::size_t> argument_types;
+        std::size_t index;
+    };
+
+private:
+    mutable std::shared_timed_mutex mutex_;
+    std::unordered_multimap<std::uint64_t, entry> entries_;
+};
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "reflection_info.hpp"
+
+
+namespace shadow
+{
+// one leaf value of a flattened object, together with the punctuation of the
+// text format written before it
+struct serialization_step
+{
+    // text written before the value, eg. "{" or ", {"
+    std::string prefix;
+    // offset of the value from the start of the outermost object
+    std::size_t offset;
+    // serializers of the value, nullptr for a last step only writing prefix
+    const serialization_info* leaf;
+};
+
+// the leaf values of a type with nested member variables flattened, in the
+// order they are serialized
+struct serialization_plan
+{
+    std::vector<serialization_step> steps;
+};
+
+
+// plans by type index, built on first use
+// lookups only take a shared lock, so any number of threads serializing
+// through a const reflection_manager can read concurrently. Plans are never
+// removed, so pointers to them stay valid for the life of the cache.
+class serialization_plan_cache
+{
+public:
+    serialization_plan_cache() : mutex_(), plans_()
+    {
+    }
+
+    // plans are not shared between copies
+    serialization_plan_cache(const serialization_plan_cache&)
+        : mutex_(), plans_()
+    {
+    }
+
+    serialization_plan_cache&
+    operator=(const serialization_plan_cache& other)
+    {
+        if(this != &other)
+        {
+            std::lock_guard<std::shared_timed_mutex> lock(mutex_);
+            plans_.clear();
+        }
+
+        return *this;
+    }
+
+    // returns plan for type_index, calling build() to make it if there is
+    // none yet
+    template <class Builder>
+    const serialization_plan&
+    get(std::size_t type_index, Builder&& build) const
+    {
+        {
+            std::shared_lock<std::shared_timed_mutex> lock(mutex_);
+
+            if(type_index < plans_.size() && plans_[type_index] != nullptr)
+            {
+                return *plans_[type_index];
+            }
+        }
+
+        std::lock_guard<std::shared_timed_mutex> lock(mutex_);
+
+        if(type_index >= plans_.size())
+        {
+            plans_.resize(type_index + 1);
+        }
+
+        // another thread may have built it while waiting for the lock
+        if(plans_[type_index] == nullptr)
+        {
+            plans_[type_index] =
+                std::make_unique<serialization_plan>(build());
+        }
+
+        return *plans_[type_index];
+    }
+
+private:
+    mutable std::shared_timed_mutex mutex_;
+    mutable std::vector<std::unique_ptr<serialization_plan>> plans_;
+};
+}
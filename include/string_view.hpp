@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+
+
+namespace shadow
+{
+// non-owning view of a sequence of chars, used to pass names to the
+// reflection_manager without allocating
+// stands in for std::string_view, which is not available in C++14
+class string_view
+{
+public:
+    typedef const char* const_iterator;
+
+public:
+    constexpr string_view() noexcept : data_(nullptr), size_(0)
+    {
+    }
+
+    constexpr string_view(const char* data, std::size_t size) noexcept
+        : data_(data), size_(size)
+    {
+    }
+
+    string_view(const char* str) : data_(str), size_(std::strlen(str))
+    {
+    }
+
+    string_view(const std::string& str) noexcept
+        : data_(str.data()), size_(str.size())
+    {
+    }
+
+public:
+    constexpr const char*
+    data() const noexcept
+    {
+        return data_;
+    }
+
+    constexpr std::size_t
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    constexpr bool
+    empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    constexpr const_iterator
+    begin() const noexcept
+    {
+        return data_;
+    }
+
+    constexpr const_iterator
+    end() const noexcept
+    {
+        return data_ + size_;
+    }
+
+    constexpr char operator[](std::size_t index) const
+    {
+        return data_[index];
+    }
+
+    std::string
+    to_string() const
+    {
+        return std::string(data_, size_);
+    }
+
+private:
+    const char* data_;
+    std::size_t size_;
+};
+
+
+inline bool
+operator==(string_view lhs, string_view rhs)
+{
+    // data() of an empty view may be null, which memcmp doesn't accept
+    return lhs.size() == rhs.size() &&
+           (lhs.size() == 0 ||
+            std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0);
+}
+
+// compare against null terminated string without measuring it first
+inline bool
+operator==(string_view lhs, const char* rhs)
+{
+    // stops at the first mismatch or at the terminator, so rhs is never read
+    // past its end
+    for(std::size_t index = 0;; ++index)
+    {
+        if(rhs[index] == '\0')
+        {
+            return index == lhs.size();
+        }
+
+        if(index == lhs.size() || rhs[index] != lhs[index])
+        {
+            return false;
+        }
+    }
+}
+
+inline bool
+operator==(const char* lhs, string_view rhs)
+{
+    return rhs == lhs;
+}
+
+inline bool
+operator!=(string_view lhs, string_view rhs)
+{
+    return !(lhs == rhs);
+}
+
+inline bool
+operator!=(string_view lhs, const char* rhs)
+{
+    return !(lhs == rhs);
+}
+
+inline bool
+operator!=(const char* lhs, string_view rhs)
+{
+    return !(rhs == lhs);
+}
+
+inline std::ostream&
+operator<<(std::ostream& out, string_view str)
+{
+    return out.write(str.data(), str.size());
+}
+}
@@ -0,0 +1,419 @@
+#pragma once
+
+#include <algorithm>
+#include <clocale>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#include "exceptions.hpp"
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+
+// formatting and parsing of values in char ranges for the buffer based text
+// serialization
+// the write functions write to the range first -> last and return a pointer
+// past the chars written, or nullptr if the text doesn't fit, similar to
+// std::to_chars
+// the read functions skip leading whitespace, parse a value from the range
+// first -> last and return a pointer past the text parsed. They throw
+// serialization_error if the text is malformed.
+namespace shadow
+{
+namespace text_format
+{
+inline char*
+write_chars(char* first, char* last, const char* str, std::size_t size)
+{
+    if(static_cast<std::size_t>(last - first) < size)
+    {
+        return nullptr;
+    }
+
+    std::memcpy(first, str, size);
+
+    return first + size;
+}
+
+inline char*
+write_char(char* first, char* last, char c)
+{
+    if(first == last)
+    {
+        return nullptr;
+    }
+
+    *first = c;
+
+    return first + 1;
+}
+
+
+template <class T>
+char*
+write_integer(char* first, char* last, T value)
+{
+    typedef std::make_unsigned_t<T> unsigned_type;
+
+    // digits of the largest value plus a sign
+    char digits[std::numeric_limits<unsigned_type>::digits10 + 2];
+    char* digits_end = digits + sizeof(digits);
+    char* digit = digits_end;
+
+    unsigned_type magnitude = static_cast<unsigned_type>(value);
+    const bool negative = value < 0;
+    if(negative)
+    {
+        magnitude = static_cast<unsigned_type>(0 - magnitude);
+    }
+
+    do
+    {
+        *--digit = static_cast<char>('0' + magnitude % 10);
+        magnitude = static_cast<unsigned_type>(magnitude / 10);
+    } while(magnitude != 0);
+
+    if(negative)
+    {
+        *--digit = '-';
+    }
+
+    return write_chars(first, last, digit, digits_end - digit);
+}
+
+
+namespace detail
+{
+inline float
+parse_floating(const char* str, char** end, float*)
+{
+    return std::strtof(str, end);
+}
+
+inline double
+parse_floating(const char* str, char** end, double*)
+{
+    return std::strtod(str, end);
+}
+
+inline long double
+parse_floating(const char* str, char** end, long double*)
+{
+    return std::strtold(str, end);
+}
+
+inline int
+format_floating(char* out, std::size_t size, int precision, double value)
+{
+    return std::snprintf(out, size, "%.*g", precision, value);
+}
+
+inline int
+format_floating(char* out, std::size_t size, int precision, long double value)
+{
+    return std::snprintf(out, size, "%.*Lg", precision, value);
+}
+} // namespace detail
+
+
+// shortest text that reads back to the same value
+template <class T>
+char*
+write_floating(char* first, char* last, T value)
+{
+#if defined(__cpp_lib_to_chars)
+    const auto result = std::to_chars(first, last, value);
+
+    return result.ec == std::errc() ? result.ptr : nullptr;
+#else
+    // printf has no shortest round trip format, so try increasing precision
+    // until the value reads back the same
+    char text[64];
+    int size = 0;
+
+    for(int precision = std::numeric_limits<T>::digits10;
+        precision <= std::numeric_limits<T>::max_digits10;
+        ++precision)
+    {
+        size = detail::format_floating(text, sizeof(text), precision, value);
+
+        if(detail::parse_floating(text, nullptr, static_cast<T*>(nullptr)) ==
+           value)
+        {
+            break;
+        }
+    }
+
+    // printf and strtod follow the C locale, the text format always uses '.'
+    const char decimal_point = *std::localeconv()->decimal_point;
+    if(decimal_point != '.')
+    {
+        std::replace(text, text + size, decimal_point, '.');
+    }
+
+    return write_chars(first, last, text, size);
+#endif
+}
+
+
+// char types are written as the char itself, like operator<< does
+template <class T>
+struct is_character
+    : std::integral_constant<bool,
+                             std::is_same<T, char>::value ||
+                                 std::is_same<T, signed char>::value ||
+                                 std::is_same<T, unsigned char>::value>
+{
+};
+
+template <class T>
+std::enable_if_t<is_character<T>::value, char*>
+write_arithmetic(char* first, char* last, T value)
+{
+    return write_char(first, last, static_cast<char>(value));
+}
+
+template <class T>
+std::enable_if_t<std::is_integral<T>::value && !is_character<T>::value, char*>
+write_arithmetic(char* first, char* last, T value)
+{
+    return write_integer(first, last, value);
+}
+
+template <class T>
+std::enable_if_t<std::is_floating_point<T>::value, char*>
+write_arithmetic(char* first, char* last, T value)
+{
+    return write_floating(first, last, value);
+}
+
+
+inline const char*
+skip_space(const char* first, const char* last)
+{
+    while(first != last && (*first == ' ' || *first == '\t' ||
+                            *first == '\n' || *first == '\r'))
+    {
+        ++first;
+    }
+
+    return first;
+}
+
+// skip whitespace followed by c
+inline const char*
+read_char(const char* first, const char* last, char c)
+{
+    first = skip_space(first, last);
+
+    if(first == last || *first != c)
+    {
+        throw serialization_error(std::string("expected '") + c + '\'');
+    }
+
+    return first + 1;
+}
+
+inline const char*
+read_char(const char* first, const char* last, char* value)
+{
+    first = skip_space(first, last);
+
+    if(first == last)
+    {
+        throw serialization_error("expected char");
+    }
+
+    *value = *first;
+
+    return first + 1;
+}
+
+
+template <class T>
+const char*
+read_integer(const char* first, const char* last, T& value)
+{
+    typedef std::make_unsigned_t<T> unsigned_type;
+
+    first = skip_space(first, last);
+
+    bool negative = false;
+    if(first != last && (*first == '-' || *first == '+'))
+    {
+        negative = *first == '-';
+        ++first;
+    }
+
+    if(negative && std::is_unsigned<T>::value)
+    {
+        throw serialization_error("negative value for unsigned type");
+    }
+
+    const unsigned_type limit =
+        negative ? static_cast<unsigned_type>(
+                       0 - static_cast<unsigned_type>(
+                               std::numeric_limits<T>::min()))
+                 : static_cast<unsigned_type>(std::numeric_limits<T>::max());
+
+    const char* digits_begin = first;
+    unsigned_type magnitude = 0;
+
+    for(; first != last && *first >= '0' && *first <= '9'; ++first)
+    {
+        const unsigned_type digit = static_cast<unsigned_type>(*first - '0');
+
+        if(magnitude > static_cast<unsigned_type>((limit - digit) / 10))
+        {
+            throw serialization_error("integer out of range");
+        }
+
+        magnitude = static_cast<unsigned_type>(magnitude * 10 + digit);
+    }
+
+    if(first == digits_begin)
+    {
+        throw serialization_error("expected integer");
+    }
+
+    // negate without overflowing for the minimum value
+    value = negative && magnitude != 0
+                ? static_cast<T>(-static_cast<T>(magnitude - 1) - 1)
+                : static_cast<T>(magnitude);
+
+    return first;
+}
+
+
+template <class T>
+const char*
+read_floating(const char* first, const char* last, T& value)
+{
+    first = skip_space(first, last);
+
+#if defined(__cpp_lib_to_chars)
+    const auto result = std::from_chars(first, last, value);
+
+    if(result.ec != std::errc())
+    {
+        throw serialization_error("expected floating point number");
+    }
+
+    return result.ptr;
+#else
+    // copy the token to be able to null terminate it for strtod
+    char token[128];
+    std::size_t size = 0;
+
+    for(const char* c = first; c != last && size < sizeof(token) - 1; ++c)
+    {
+        if(!((*c >= '0' && *c <= '9') || (*c >= 'a' && *c <= 'z') ||
+             (*c >= 'A' && *c <= 'Z') || *c == '.' || *c == '-' ||
+             *c == '+'))
+        {
+            break;
+        }
+
+        token[size++] = *c;
+    }
+    token[size] = '\0';
+
+    // strtod follows the C locale, the text format always uses '.'
+    const char decimal_point = *std::localeconv()->decimal_point;
+    if(decimal_point != '.')
+    {
+        std::replace(token, token + size, '.', decimal_point);
+    }
+
+    char* token_end = token;
+    value =
+        detail::parse_floating(token, &token_end, static_cast<T*>(nullptr));
+
+    if(token_end == token)
+    {
+        throw serialization_error("expected floating point number");
+    }
+
+    return first + (token_end - token);
+#endif
+}
+
+
+template <class T>
+std::enable_if_t<is_character<T>::value, const char*>
+read_arithmetic(const char* first, const char* last, T& value)
+{
+    char c;
+    first = read_char(first, last, &c);
+    value = static_cast<T>(c);
+
+    return first;
+}
+
+template <class T>
+std::enable_if_t<std::is_integral<T>::value && !is_character<T>::value,
+                 const char*>
+read_arithmetic(const char* first, const char* last, T& value)
+{
+    return read_integer(first, last, value);
+}
+
+template <class T>
+std::enable_if_t<std::is_floating_point<T>::value, const char*>
+read_arithmetic(const char* first, const char* last, T& value)
+{
+    return read_floating(first, last, value);
+}
+
+
+inline const char*
+read_bool(const char* first, const char* last, bool& value)
+{
+    first = skip_space(first, last);
+
+    const std::size_t size = last - first;
+    if(size >= 4 && std::memcmp(first, "true", 4) == 0)
+    {
+        value = true;
+        return first + 4;
+    }
+
+    if(size >= 5 && std::memcmp(first, "false", 5) == 0)
+    {
+        value = false;
+        return first + 5;
+    }
+
+    throw serialization_error("expected true or false");
+}
+
+
+// string surrounded by double quotes
+inline const char*
+read_string(const char* first, const char* last, std::string& value)
+{
+    first = read_char(first, last, '"');
+
+    const auto end =
+        static_cast<const char*>(std::memchr(first, '"', last - first));
+
+    if(end == nullptr)
+    {
+        throw serialization_error("expected closing '\"'");
+    }
+
+    value.assign(first, end);
+
+    return end + 1;
+}
+} // namespace text_format
+} // namespace shadow
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "reflection_binding.hpp"
+
+
+namespace shadow
+{
+class reflection_manager;
+
+
+namespace invoke_detail
+{
+// arguments are passed to the trampolines by address, so arrays, eg. string
+// literals, are first decayed to the pointers the parameters expect
+template <class T>
+inline T&
+pass_argument(T& arg)
+{
+    return arg;
+}
+
+template <class T, std::size_t N>
+inline T*
+pass_argument(T (&arg)[N])
+{
+    return arg;
+}
+
+// true for arguments of type Arg, as deduced for a forwarding reference, that
+// a parameter may write through: non-const lvalues and pointers to non-const
+template <class Arg>
+struct is_writable_argument
+    : std::integral_constant<
+          bool,
+          std::is_pointer<std::decay_t<Arg>>::value
+              ? !std::is_const<
+                    std::remove_pointer_t<std::decay_t<Arg>>>::value
+              : std::is_lvalue_reference<Arg>::value &&
+                    !std::is_const<std::remove_reference_t<Arg>>::value>
+{
+};
+
+// the const_cast only reaches objects passed to parameters that don't write
+// through them, as reflection_manager checks is_writable_argument for the
+// others
+template <class T>
+inline void*
+address_of_argument(T& arg)
+{
+    return const_cast<void*>(static_cast<const void*>(std::addressof(arg)));
+}
+
+
+template <class ReturnType>
+struct caller
+{
+    template <class... Args>
+    static ReturnType
+    call(free_function_invoke_signature invoke_bind_point, Args&&... args)
+    {
+        // trailing nullptr avoids an empty array for functions without
+        // parameters
+        void* const argument_array[] = {address_of_argument(args)..., nullptr};
+
+        std::aligned_storage_t<sizeof(ReturnType), alignof(ReturnType)> result;
+        invoke_bind_point(&result, argument_array);
+
+        auto& value = *reinterpret_cast<ReturnType*>(&result);
+        ReturnType out(std::move(value));
+        value.~ReturnType();
+
+        return out;
+    }
+};
+
+template <>
+struct caller<void>
+{
+    template <class... Args>
+    static void
+    call(free_function_invoke_signature invoke_bind_point, Args&&... args)
+    {
+        void* const argument_array[] = {address_of_argument(args)..., nullptr};
+
+        invoke_bind_point(nullptr, argument_array);
+    }
+};
+
+
+// parameters of typed_free_function::operator(), values are taken by const
+// reference as the trampoline copies them, references as declared in the
+// signature
+template <class T>
+using parameter_reference_t =
+    std::conditional_t<std::is_reference<T>::value, T, const T&>;
+} // namespace invoke_detail
+
+
+template <class Signature>
+class typed_free_function;
+
+// free function with signature ReturnType(ParamTypes...) checked when made by
+// reflection_manager::free_function_handle, calls go directly to its typed
+// trampoline without checking or boxing the arguments
+template <class ReturnType, class... ParamTypes>
+class typed_free_function<ReturnType(ParamTypes...)>
+{
+    friend class reflection_manager;
+
+public:
+    ReturnType
+    operator()(
+        invoke_detail::parameter_reference_t<ParamTypes>... args) const
+    {
+        return invoke_detail::caller<ReturnType>::call(invoke_bind_point_,
+                                                       args...);
+    }
+
+private:
+    explicit typed_free_function(
+        free_function_invoke_signature invoke_bind_point)
+        : invoke_bind_point_(invoke_bind_point)
+    {
+    }
+
+private:
+    free_function_invoke_signature invoke_bind_point_;
+};
+}
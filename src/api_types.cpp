@@ -24,6 +24,16 @@ object::type() const
 }
 
 
+object
+object::reference_to(const object& obj)
+{
+    return object(any::reference_to(const_cast<void*>(obj.value_.data()),
+                                    obj.type_info_->operations),
+                  obj.type_info_,
+                  obj.manager_);
+}
+
+
 constexpr const type_info object::void_info;
 
 
@@ -38,14 +48,9 @@ operator<<(std::ostream& out, const object& obj)
     // find default serialization_info for obj
     const auto t_index = obj.manager_->index_of_object(obj);
 
-    auto found =
-        std::find_if(obj.manager_->serialization_info_view_.cbegin(),
-                     obj.manager_->serialization_info_view_.cend(),
-                     [t_index](const auto& si) {
-                         return si.type_index == t_index &&
-                                std::string(si.name) == std::string("default");
-                     });
-    if(found != obj.manager_->serialization_info_view_.cend())
+    const auto found = obj.manager_->default_serialization_by_type_[t_index];
+
+    if(found != nullptr)
     {
         return found->serialization_bind_point(out, obj.value_);
     }
@@ -62,6 +67,8 @@ operator<<(std::ostream& out, const object& obj)
                 out << obj.manager_->get_member_variable(obj, mv);
             });
 
+        out << '}';
+
         return out;
     }
 
@@ -88,15 +95,9 @@ operator>>(std::istream& in, object& obj)
     // find default serialization_info for obj
     const auto t_index = obj.manager_->index_of_object(obj);
 
-    auto found =
-        std::find_if(obj.manager_->serialization_info_view_.cbegin(),
-                     obj.manager_->serialization_info_view_.cend(),
-                     [t_index](const auto& si) {
-                         return si.type_index == t_index &&
-                                std::string(si.name) == std::string("default");
-                     });
+    const auto found = obj.manager_->default_serialization_by_type_[t_index];
 
-    if(found != obj.manager_->serialization_info_view_.cend())
+    if(found != nullptr)
     {
         return found->deserialization_bind_point(in, obj.value_);
     }
@@ -0,0 +1,124 @@
+#include "bound_call.hpp"
+
+
+namespace shadow
+{
+bound_call::bound_call(const bound_call& other)
+    : manager_(other.manager_),
+      free_bind_point_(other.free_bind_point_),
+      member_bind_point_(other.member_bind_point_),
+      class_info_(other.class_info_),
+      return_info_(other.return_info_),
+      pointer_flags_(other.pointer_flags_),
+      parameter_infos_(other.parameter_infos_),
+      arguments_(other.arguments_),
+      pointees_(other.pointees_)
+{
+    // the copied slots still point to the values of other
+    bind_pointers();
+}
+
+bound_call&
+bound_call::operator=(const bound_call& other)
+{
+    if(this != &other)
+    {
+        auto temp = other;
+        *this = std::move(temp);
+    }
+
+    return *this;
+}
+
+
+object_reference
+bound_call::argument(std::size_t index)
+{
+    if(index >= arguments_.size())
+    {
+        throw argument_error("argument index out of range");
+    }
+
+    return object_reference(
+        object(any::reference_to(value_of(index).data(),
+                                 parameter_infos_[index]->operations),
+               parameter_infos_[index],
+               manager_));
+}
+
+void
+bound_call::set_argument(std::size_t index, const object& val)
+{
+    if(index >= arguments_.size())
+    {
+        throw argument_error("argument index out of range");
+    }
+
+    if(val.type_info_ != parameter_infos_[index] &&
+       val.type() != type_tag(*parameter_infos_[index]))
+    {
+        throw argument_error("argument of wrong type");
+    }
+
+    value_of(index) = val.value_;
+
+    if(pointer_flags_[index])
+    {
+        // the value may have moved to a new heap allocation
+        arguments_[index] =
+            parameter_infos_[index]->address_of_bind_point(pointees_[index]);
+    }
+}
+
+
+object
+bound_call::call()
+{
+    if(free_bind_point_ == nullptr)
+    {
+        throw argument_error("bound member function requires an object");
+    }
+
+    return object(free_bind_point_(arguments_.data()), return_info_, manager_);
+}
+
+object
+bound_call::call(object& obj)
+{
+    if(member_bind_point_ == nullptr)
+    {
+        throw argument_error("bound free function can't take an object");
+    }
+
+    if(obj.type_info_ != class_info_ && obj.type() != type_tag(*class_info_))
+    {
+        throw type_error(
+            "attempting to call member function on object of wrong class");
+    }
+
+    return object(member_bind_point_(obj.value_, arguments_.data()),
+                  return_info_,
+                  manager_);
+}
+
+
+any&
+bound_call::value_of(std::size_t index)
+{
+    return pointer_flags_[index] ? pointees_[index] : arguments_[index];
+}
+
+void
+bound_call::bind_pointers()
+{
+    for(std::size_t index = 0; index < arguments_.size(); ++index)
+    {
+        if(pointer_flags_[index])
+        {
+            arguments_[index] =
+                parameter_infos_[index]->address_of_bind_point(
+                    pointees_[index]);
+        }
+    }
+}
+}
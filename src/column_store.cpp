@@ -0,0 +1,161 @@
+#include "column_store.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+
+namespace shadow
+{
+column_store::column_store(const reflection_manager& manager,
+                           const type_tag& tag)
+    : manager_(&manager),
+      type_(tag),
+      columns_(),
+      size_(0),
+      has_default_constructor_(false),
+      default_constructor_()
+{
+    if(!manager.type_is_standard_layout(tag))
+    {
+        throw type_error("column_store requires a standard layout type");
+    }
+
+    const auto fields = manager.member_variables_by_class_type(tag);
+
+    std::for_each(
+        fields.first, fields.second, [this, &manager](const auto& field) {
+            const auto field_type = manager.member_variable_type(field);
+
+            if(!manager.type_is_trivially_copyable(field_type))
+            {
+                throw type_error("column_store requires trivially copyable "
+                                 "member variables");
+            }
+
+            if(manager.type_alignment(field_type) > alignof(std::max_align_t))
+            {
+                throw type_error("column_store member variable type is over "
+                                 "aligned");
+            }
+
+            columns_.push_back(
+                column_data{field,
+                            manager.member_variable_offset(field),
+                            manager.type_size(field_type),
+                            std::vector<char>()});
+        });
+
+    const auto constructors = manager.constructors_by_type(tag);
+
+    const auto default_constructor = std::find_if(
+        constructors.first, constructors.second, [&manager](const auto& ctor) {
+            const auto params = manager.constructor_parameter_types(ctor);
+            return params.first == params.second;
+        });
+
+    if(default_constructor != constructors.second)
+    {
+        has_default_constructor_ = true;
+        default_constructor_ = *default_constructor;
+    }
+}
+
+
+void
+column_store::reserve(std::size_t rows)
+{
+    for(auto& col : columns_)
+    {
+        col.bytes.reserve(rows * col.size);
+    }
+}
+
+void
+column_store::clear()
+{
+    for(auto& col : columns_)
+    {
+        col.bytes.clear();
+    }
+
+    size_ = 0;
+}
+
+
+void
+column_store::push_back(const object& obj)
+{
+    if(obj.type() != type_)
+    {
+        throw type_error("object type doesn't match column_store type");
+    }
+
+    // grow every column before copying, so a failed allocation leaves the
+    // columns the same length
+    for(auto& col : columns_)
+    {
+        if(col.bytes.capacity() < (size_ + 1) * col.size)
+        {
+            col.bytes.reserve(std::max(2 * col.bytes.capacity(),
+                                       (size_ + 1) * col.size));
+        }
+    }
+
+    for(auto& col : columns_)
+    {
+        const auto field = static_cast<const char*>(
+            manager_->member_variable_reference(obj, col.field).address());
+
+        col.bytes.insert(col.bytes.end(), field, field + col.size);
+    }
+
+    ++size_;
+}
+
+
+object
+column_store::row(std::size_t index) const
+{
+    if(index >= size_)
+    {
+        throw argument_error("row index out of range");
+    }
+
+    if(!has_default_constructor_)
+    {
+        throw type_error("column_store type has no default constructor");
+    }
+
+    auto out = manager_->construct_object(default_constructor_);
+
+    for(const auto& col : columns_)
+    {
+        const auto field =
+            manager_->member_variable_reference(out, col.field).address();
+
+        std::memcpy(field, col.bytes.data() + index * col.size, col.size);
+    }
+
+    return out;
+}
+
+
+const column_store::column_data&
+column_store::column_of(const member_variable_tag& field) const
+{
+    if(manager_->member_variable_class_type(field) != type_)
+    {
+        throw type_error("member variable doesn't belong to column_store type");
+    }
+
+    const auto offset = manager_->member_variable_offset(field);
+
+    const auto found = std::find_if(
+        columns_.begin(), columns_.end(), [offset](const column_data& col) {
+            return col.offset == offset;
+        });
+
+    return *found;
+}
+}
@@ -0,0 +1,134 @@
+#include "mapped_file.hpp"
+
+#include <cerrno>
+#include <system_error>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define SHADOW_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+
+namespace shadow
+{
+#ifdef SHADOW_HAS_MMAP
+mapped_file::mapped_file(const std::string& path)
+    : data_(nullptr), size_(0), mapped_(false), buffer_()
+{
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd == -1)
+    {
+        throw std::system_error(
+            errno, std::generic_category(), "can't open " + path);
+    }
+
+    struct stat file_stat;
+    if(::fstat(fd, &file_stat) == -1)
+    {
+        const int error = errno;
+        ::close(fd);
+        throw std::system_error(
+            error, std::generic_category(), "can't stat " + path);
+    }
+
+    size_ = static_cast<std::size_t>(file_stat.st_size);
+
+    // mapping an empty file fails, leave it as an empty view instead
+    if(size_ != 0)
+    {
+        void* address =
+            ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if(address == MAP_FAILED)
+        {
+            const int error = errno;
+            ::close(fd);
+            throw std::system_error(
+                error, std::generic_category(), "can't map " + path);
+        }
+
+        data_ = static_cast<const char*>(address);
+        mapped_ = true;
+    }
+
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+}
+
+void
+mapped_file::unmap()
+{
+    if(mapped_)
+    {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+}
+#else
+mapped_file::mapped_file(const std::string& path)
+    : data_(nullptr), size_(0), mapped_(false), buffer_()
+{
+    std::ifstream file(path, std::ios::binary);
+    if(!file)
+    {
+        throw std::system_error(std::make_error_code(
+                                    std::errc::no_such_file_or_directory),
+                                "can't open " + path);
+    }
+
+    buffer_.assign(std::istreambuf_iterator<char>(file),
+                   std::istreambuf_iterator<char>());
+
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+}
+
+void
+mapped_file::unmap()
+{
+}
+#endif
+
+
+mapped_file::mapped_file(mapped_file&& other) noexcept
+    : data_(other.data_),
+      size_(other.size_),
+      mapped_(other.mapped_),
+      buffer_(std::move(other.buffer_))
+{
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.mapped_ = false;
+}
+
+mapped_file&
+mapped_file::operator=(mapped_file&& other) noexcept
+{
+    if(this != &other)
+    {
+        unmap();
+
+        data_ = other.data_;
+        size_ = other.size_;
+        mapped_ = other.mapped_;
+        buffer_ = std::move(other.buffer_);
+
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.mapped_ = false;
+    }
+
+    return *this;
+}
+
+mapped_file::~mapped_file()
+{
+    unmap();
+}
+}
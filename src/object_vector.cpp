@@ -0,0 +1,365 @@
+#include "object_vector.hpp"
+
+#include <cstring>
+#include <new>
+#include <utility>
+
+
+namespace shadow
+{
+object_vector::object_vector(const reflection_manager& manager,
+                             const type_tag& tag)
+    : manager_(&manager),
+      type_info_(tag.info_ptr_),
+      data_(nullptr),
+      size_(0),
+      capacity_(0)
+{
+    if(type_info_->operations == nullptr)
+    {
+        throw type_error("object_vector requires a copyable type");
+    }
+
+    if(type_info_->alignment > alignof(std::max_align_t))
+    {
+        throw type_error("object_vector type is over aligned");
+    }
+}
+
+
+object_vector::object_vector(const object_vector& other)
+    : manager_(other.manager_),
+      type_info_(other.type_info_),
+      data_(nullptr),
+      size_(0),
+      capacity_(0)
+{
+    reserve(other.size_);
+
+    try
+    {
+        for(; size_ < other.size_; ++size_)
+        {
+            copy_value(other.address_of(size_), address_of(size_));
+        }
+    }
+    catch(...)
+    {
+        destroy(0, size_);
+        ::operator delete(data_);
+        throw;
+    }
+}
+
+object_vector::object_vector(object_vector&& other) noexcept
+    : manager_(other.manager_),
+      type_info_(other.type_info_),
+      data_(other.data_),
+      size_(other.size_),
+      capacity_(other.capacity_)
+{
+    other.data_ = nullptr;
+    other.size_ = 0;
+    other.capacity_ = 0;
+}
+
+object_vector&
+object_vector::operator=(const object_vector& other)
+{
+    if(this != &other)
+    {
+        auto temp = other;
+        *this = std::move(temp);
+    }
+
+    return *this;
+}
+
+object_vector&
+object_vector::operator=(object_vector&& other) noexcept
+{
+    if(this != &other)
+    {
+        destroy(0, size_);
+        ::operator delete(data_);
+
+        manager_ = other.manager_;
+        type_info_ = other.type_info_;
+        data_ = other.data_;
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+
+        other.data_ = nullptr;
+        other.size_ = 0;
+        other.capacity_ = 0;
+    }
+
+    return *this;
+}
+
+object_vector::~object_vector()
+{
+    destroy(0, size_);
+    ::operator delete(data_);
+}
+
+
+void
+object_vector::reserve(std::size_t new_capacity)
+{
+    if(new_capacity <= capacity_)
+    {
+        return;
+    }
+
+    const auto new_data = allocate(new_capacity);
+
+    try
+    {
+        relocate(data_, new_data, size_);
+    }
+    catch(...)
+    {
+        ::operator delete(new_data);
+        throw;
+    }
+
+    ::operator delete(data_);
+
+    data_ = new_data;
+    capacity_ = new_capacity;
+}
+
+void
+object_vector::clear()
+{
+    destroy(0, size_);
+    size_ = 0;
+}
+
+
+void
+object_vector::resize(std::size_t new_size, const object& value)
+{
+    if(new_size <= size_)
+    {
+        destroy(new_size, size_);
+        size_ = new_size;
+        return;
+    }
+
+    if(value.type_info_ != type_info_ && value.type() != type())
+    {
+        throw type_error("object type doesn't match object_vector type");
+    }
+
+    // value may refer to a value of this vector
+    const object copy(value);
+    reserve(new_size);
+
+    while(size_ < new_size)
+    {
+        copy_value(copy.value_.data(), address_of(size_));
+        ++size_;
+    }
+}
+
+
+void
+object_vector::push_back(const object& obj)
+{
+    if(obj.type_info_ != type_info_ && obj.type() != type())
+    {
+        throw type_error("object type doesn't match object_vector type");
+    }
+
+    const auto src = obj.value_.data();
+
+    if(size_ < capacity_)
+    {
+        copy_value(src, address_of(size_));
+        ++size_;
+        return;
+    }
+
+    // obj may refer to a value of this vector, so it is copied into the new
+    // storage before the old storage is released
+    const auto new_capacity = capacity_ == 0 ? 1 : capacity_ * 2;
+    const auto new_data = allocate(new_capacity);
+
+    const auto new_value = new_data + size_ * type_info_->size;
+
+    try
+    {
+        copy_value(src, new_value);
+    }
+    catch(...)
+    {
+        ::operator delete(new_data);
+        throw;
+    }
+
+    try
+    {
+        relocate(data_, new_data, size_);
+    }
+    catch(...)
+    {
+        if(!type_info_->trivially_copyable)
+        {
+            type_info_->operations->destroy(new_value);
+        }
+
+        ::operator delete(new_data);
+        throw;
+    }
+
+    ::operator delete(data_);
+
+    data_ = new_data;
+    capacity_ = new_capacity;
+    ++size_;
+}
+
+void
+object_vector::pop_back()
+{
+    destroy(size_ - 1, size_);
+    --size_;
+}
+
+
+object_vector::reference
+object_vector::operator[](std::size_t index)
+{
+    return reference(element_at(address_of(index)));
+}
+
+object_vector::const_reference
+object_vector::operator[](std::size_t index) const
+{
+    return const_reference(element_at(address_of(index)));
+}
+
+object_vector::reference
+object_vector::at(std::size_t index)
+{
+    if(index >= size_)
+    {
+        throw argument_error("object_vector index out of range");
+    }
+
+    return (*this)[index];
+}
+
+object_vector::const_reference
+object_vector::at(std::size_t index) const
+{
+    if(index >= size_)
+    {
+        throw argument_error("object_vector index out of range");
+    }
+
+    return (*this)[index];
+}
+
+
+void*
+object_vector::address_of(std::size_t index) const
+{
+    return data_ + index * type_info_->size;
+}
+
+object
+object_vector::element_at(void* address) const
+{
+    return object(any::reference_to(address, type_info_->operations),
+                  type_info_,
+                  manager_);
+}
+
+void
+object_vector::copy_value(const void* src, void* dst) const
+{
+    if(type_info_->trivially_copyable)
+    {
+        std::memcpy(dst, src, type_info_->size);
+    }
+    else
+    {
+        type_info_->operations->copy(src, dst);
+    }
+}
+
+void
+object_vector::relocate(char* src, char* dst, std::size_t count) const
+{
+    if(count == 0)
+    {
+        return;
+    }
+
+    if(type_info_->trivially_copyable)
+    {
+        std::memcpy(dst, src, count * type_info_->size);
+        return;
+    }
+
+    const auto operations = type_info_->operations;
+    const auto size = type_info_->size;
+
+    if(operations->nothrow_move)
+    {
+        for(std::size_t index = 0; index < count; ++index)
+        {
+            operations->move(src + index * size, dst + index * size);
+        }
+
+        return;
+    }
+
+    std::size_t copied = 0;
+
+    try
+    {
+        for(; copied < count; ++copied)
+        {
+            operations->copy(src + copied * size, dst + copied * size);
+        }
+    }
+    catch(...)
+    {
+        for(std::size_t index = 0; index < copied; ++index)
+        {
+            operations->destroy(dst + index * size);
+        }
+
+        throw;
+    }
+
+    for(std::size_t index = 0; index < count; ++index)
+    {
+        operations->destroy(src + index * size);
+    }
+}
+
+void
+object_vector::destroy(std::size_t first, std::size_t last)
+{
+    if(type_info_->trivially_copyable)
+    {
+        return;
+    }
+
+    for(; first < last; ++first)
+    {
+        type_info_->operations->destroy(address_of(first));
+    }
+}
+
+char*
+object_vector::allocate(std::size_t capacity) const
+{
+    return static_cast<char*>(::operator new(capacity * type_info_->size));
+}
+}
@@ -0,0 +1,102 @@
+#include "record_view.hpp"
+
+#include <algorithm>
+
+
+namespace shadow
+{
+record_view::record_view(const reflection_manager& manager,
+                         const type_tag& tag,
+                         const void* data,
+                         std::size_t size)
+    : manager_(&manager),
+      type_(tag),
+      data_(static_cast<const char*>(data)),
+      record_size_(manager.type_size(tag)),
+      num_records_(0)
+{
+    if(!manager.type_is_trivially_copyable(tag))
+    {
+        throw type_error("record_view requires a trivially copyable type");
+    }
+
+    if(record_size_ == 0 || size % record_size_ != 0)
+    {
+        throw serialization_error(
+            "size of data isn't a multiple of the size of the record type");
+    }
+
+    const auto fields = manager.member_variables_by_class_type(tag);
+
+    std::for_each(
+        fields.first, fields.second, [this, &manager](const auto& field) {
+            const auto field_type = manager.member_variable_type(field);
+
+            if(!manager.type_is_trivially_copyable(field_type))
+            {
+                throw type_error(
+                    "record_view requires trivially copyable member variables");
+            }
+
+            if(manager.member_variable_offset(field) +
+                   manager.type_size(field_type) >
+               record_size_)
+            {
+                throw serialization_error(
+                    "member variable doesn't fit within record");
+            }
+        });
+
+    num_records_ = size / record_size_;
+}
+
+
+record_view::record_view(const reflection_manager& manager,
+                         const type_tag& tag,
+                         const void* data,
+                         std::size_t size,
+                         std::uint64_t schema_hash)
+    : record_view(manager, tag, data, size)
+{
+    if(manager.type_schema_hash(tag) != schema_hash)
+    {
+        throw serialization_error(
+            "schema of data doesn't match schema of the record type");
+    }
+}
+
+
+const void*
+record_view::record(std::size_t index) const
+{
+    if(index >= num_records_)
+    {
+        throw argument_error("record index out of range");
+    }
+
+    return data_ + index * record_size_;
+}
+
+
+const void*
+record_view::field(std::size_t index, const member_variable_tag& field) const
+{
+    const auto layout = layout_of(field);
+
+    return static_cast<const char*>(record(index)) + layout.offset;
+}
+
+
+record_view::field_layout
+record_view::layout_of(const member_variable_tag& field) const
+{
+    if(manager_->member_variable_class_type(field) != type_)
+    {
+        throw type_error("member variable doesn't belong to the record type");
+    }
+
+    return field_layout{
+        manager_->member_variable_offset(field),
+        manager_->type_size(manager_->member_variable_type(field))};
+}
+}
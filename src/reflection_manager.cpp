@@ -1,10 +1,17 @@
 #include "reflection_manager.hpp"
 
+#include <cstring>
+#include <functional>
+
 #include "exceptions.hpp"
+#include "object_vector.hpp"
 
 
 namespace shadow
 {
+constexpr std::size_t hash_index::npos;
+
+
 std::pair<typename reflection_manager::const_type_iterator,
           typename reflection_manager::const_type_iterator>
 reflection_manager::types() const
@@ -20,12 +27,50 @@ reflection_manager::type_name(const type_tag& tag) const
     return tag.name();
 }
 
+string_view
+reflection_manager::type_name_view(const type_tag& tag) const
+{
+    return tag.name_view();
+}
+
 std::size_t
 reflection_manager::type_size(const type_tag& tag) const
 {
     return tag.size();
 }
 
+std::size_t
+reflection_manager::type_alignment(const type_tag& tag) const
+{
+    return tag.info_ptr_->alignment;
+}
+
+bool
+reflection_manager::type_is_trivially_copyable(const type_tag& tag) const
+{
+    return tag.info_ptr_->trivially_copyable;
+}
+
+bool
+reflection_manager::type_is_standard_layout(const type_tag& tag) const
+{
+    return tag.info_ptr_->standard_layout;
+}
+
+std::pair<const schema_field*, const schema_field*>
+reflection_manager::type_schema(const type_tag& tag) const
+{
+    const auto& schema = schemas_by_type_[index_of_type(tag)];
+
+    return std::make_pair(schema.data(), schema.data() + schema.size());
+}
+
+std::uint64_t
+reflection_manager::type_schema_hash(const type_tag& tag) const
+{
+    return schema_hashes_by_type_[index_of_type(tag)];
+}
+
 std::pair<typename reflection_manager::const_constructor_iterator,
           typename reflection_manager::const_constructor_iterator>
 reflection_manager::constructors() const
@@ -93,31 +138,165 @@ reflection_manager::compare_type(const type_tag& tag, std::size_t index) const
     return tag == tag_from_index;
 }
 
+hash_index
+reflection_manager::index_type_names() const
+{
+    hash_index out(type_info_view_.size());
+
+    for(std::size_t index = 0; index < type_info_view_.size(); ++index)
+    {
+        out.insert(name_hash_of(type_info_view_[index]), index);
+    }
+
+    return out;
+}
+
+std::vector<const serialization_info*>
+reflection_manager::default_serializations() const
+{
+    std::vector<const serialization_info*> out(type_info_view_.size(),
+                                               nullptr);
+
+    // the first "default" registered for a type is the one used
+    std::for_each(serialization_info_view_.cbegin(),
+                  serialization_info_view_.cend(),
+                  [&out](const serialization_info& info) {
+                      if(out[info.type_index] == nullptr &&
+                         std::strcmp(info.name, "default") == 0)
+                      {
+                          out[info.type_index] = &info;
+                      }
+                  });
+
+    return out;
+}
+
+std::vector<std::vector<schema_field>>
+reflection_manager::schemas() const
+{
+    std::vector<std::vector<schema_field>> out(type_info_view_.size());
+
+    for(std::size_t index = 0; index < member_variable_info_view_.size();
+        ++index)
+    {
+        const auto& info = member_variable_info_view_[index];
+
+        out[info.object_type_index].push_back(
+            schema_field{info.name,
+                         info.type_index,
+                         info.offset,
+                         type_info_view_[info.type_index].size});
+    }
+
+    for(auto& schema : out)
+    {
+        std::sort(schema.begin(),
+                  schema.end(),
+                  [](const schema_field& lhs, const schema_field& rhs) {
+                      return lhs.offset < rhs.offset;
+                  });
+    }
+
+    return out;
+}
+
+std::vector<std::uint64_t>
+reflection_manager::schema_hashes() const
+{
+    std::vector<std::uint64_t> out(type_info_view_.size(), 0);
+    std::vector<bool> done(type_info_view_.size(), false);
+
+    for(std::size_t index = 0; index < type_info_view_.size(); ++index)
+    {
+        schema_hash(index, out, done);
+    }
+
+    return out;
+}
+
+std::uint64_t
+reflection_manager::schema_hash(std::size_t type_index,
+                                std::vector<std::uint64_t>& hashes,
+                                std::vector<bool>& done) const
+{
+    if(done[type_index])
+    {
+        return hashes[type_index];
+    }
+
+    const auto& info = type_info_view_[type_index];
+
+    // type indices differ between managers, so only names, sizes and offsets
+    // go into the hash
+    auto hash = combine_hash(name_hash_of(info), info.size);
+
+    for(const auto& field : schemas_by_type_[type_index])
+    {
+        hash = combine_hash(hash, hash_name(field.name));
+        hash = combine_hash(hash, schema_hash(field.type_index, hashes, done));
+        hash = combine_hash(hash, field.offset);
+    }
+
+    hashes[type_index] = hash;
+    done[type_index] = true;
+
+    return hash;
+}
+
 std::size_t
 reflection_manager::index_of_type(const type_tag& tag) const
 {
-    auto found = std::find_if(
-        type_info_view_.cbegin(),
-        type_info_view_.cend(),
-        [&tag](const type_info& info) { return tag == type_tag(info); });
+    const auto found = find_index_of_type(tag);
 
-    if(found == type_info_view_.cend())
+    if(found == hash_index::npos)
     {
         throw type_error("type not registered in reflection_manager");
     }
 
-    return found - type_info_view_.cbegin();
+    return found;
 }
 
 std::size_t
 reflection_manager::index_of_object(const object& obj) const
+{
+    const auto found = find_index_of_object(obj);
+
+    if(found == hash_index::npos)
+    {
+        throw type_error("type not registered in reflection_manager");
+    }
+
+    return found;
+}
+
+std::size_t
+reflection_manager::find_index_of_type(const type_tag& tag) const
+{
+    const type_info* info = tag.info_ptr_;
+
+    // tags from this manager point into type_info_view_
+    std::less<const type_info*> less;
+    if(!less(info, type_info_view_.data()) &&
+       less(info, type_info_view_.data() + type_info_view_.size()))
+    {
+        return info - type_info_view_.data();
+    }
+
+    return type_indices_by_name_.find(
+        name_hash_of(*info), [this, info](std::size_t index) {
+            return std::strcmp(type_info_view_[index].name, info->name) == 0;
+        });
+}
+
+std::size_t
+reflection_manager::find_index_of_object(const object& obj) const
 {
     if(obj.manager_ == this)
     {
         return obj.type_info_ - type_info_view_.data();
     }
 
-    return index_of_type(obj.type());
+    return find_index_of_type(obj.type());
 }
 
 
@@ -157,7 +336,7 @@ reflection_manager::conversion_types(const conversion_tag& tag) const
 object
 reflection_manager::convert(const conversion_tag& tag, const object& val) const
 {
-    if(val.type() != type_tag(type_info_view_[tag.info_ptr_->from_type_index]))
+    if(!object_has_type(val, tag.info_ptr_->from_type_index))
     {
         throw type_error("type of object doesn't match conversion binding");
     }
@@ -183,6 +362,12 @@ reflection_manager::free_function_name(const free_function_tag& tag) const
     return std::string(tag.info_ptr_->name);
 }
 
+string_view
+reflection_manager::free_function_name_view(const free_function_tag& tag) const
+{
+    return name_view_of(*tag.info_ptr_);
+}
+
 type_tag
 reflection_manager::free_function_return_type(
     const free_function_tag& tag) const
@@ -217,6 +402,144 @@ reflection_manager::call_free_function(const free_function_tag& tag) const
                   this);
 }
 
+bool
+reflection_manager::free_function_has_batch_kernel(
+    const free_function_tag& tag) const
+{
+    return tag.info_ptr_->batch_kernel_bind_point != nullptr;
+}
+
+void
+reflection_manager::call_free_function_batch(const free_function_tag& tag,
+                                             object_vector* const* first,
+                                             object_vector* const* last,
+                                             object_vector& results) const
+{
+    if(!compare_type(results.type(), tag.info_ptr_->return_type_index))
+    {
+        throw type_error("results don't hold the return type");
+    }
+
+    run_batch(*tag.info_ptr_, first, last, results.size(), results.data());
+}
+
+void
+reflection_manager::call_free_function_batch(const free_function_tag& tag,
+                                             object_vector* const* first,
+                                             object_vector* const* last) const
+{
+    // void is the only type of size 0
+    if(type_info_view_[tag.info_ptr_->return_type_index].size != 0)
+    {
+        throw type_error("free function returns a value");
+    }
+
+    const std::size_t rows = first == last ? 0 : (*first)->size();
+
+    run_batch(*tag.info_ptr_, first, last, rows, nullptr);
+}
+
+void
+reflection_manager::run_batch(const free_function_info& info,
+                              object_vector* const* first,
+                              object_vector* const* last,
+                              std::size_t rows,
+                              void* results) const
+{
+    const auto batch_bind_point = batch_bind_point_of(info);
+
+    if(batch_bind_point == nullptr)
+    {
+        throw argument_error("free function has no batch trampoline");
+    }
+
+    if(static_cast<std::size_t>(std::distance(first, last)) !=
+       info.num_parameters)
+    {
+        throw argument_error("wrong number of argument columns");
+    }
+
+    std::vector<void*> columns;
+    columns.reserve(info.num_parameters);
+
+    for(std::size_t index = 0; index < info.num_parameters; ++index)
+    {
+        object_vector& column = *first[index];
+
+        if(!compare_type(column.type(), info.parameter_type_indices[index]))
+        {
+            throw argument_error("wrong argument column types");
+        }
+
+        if(column.size() != rows)
+        {
+            throw argument_error("argument columns differ in size");
+        }
+
+        columns.push_back(column.data());
+    }
+
+    batch_bind_point(results, columns.data(), rows);
+}
+
+free_function_batch_signature
+reflection_manager::batch_bind_point_of(const free_function_info& info)
+{
+    if(info.batch_kernel_bind_point != nullptr)
+    {
+        return info.batch_kernel_bind_point;
+    }
+
+    return info.batch_bind_point;
+}
+
+std::uint64_t
+reflection_manager::resolution_key(string_view name,
+                                   const std::size_t* first,
+                                   const std::size_t* last) const
+{
+    auto key = hash_name(name.data(), name.size());
+
+    for(; first != last; ++first)
+    {
+        key = combine_hash(key, *first);
+    }
+
+    return key;
+}
+
+hash_index
+reflection_manager::index_free_function_names() const
+{
+    hash_index out(free_function_info_view_.size());
+
+    for(std::size_t index = 0; index < free_function_info_view_.size();
+        ++index)
+    {
+        const auto name = name_view_of(free_function_info_view_[index]);
+        out.insert(hash_name(name.data(), name.size()), index);
+    }
+
+    return out;
+}
+
+reflection_manager::const_free_function_iterator
+reflection_manager::find_free_function(string_view name) const
+{
+    const auto found = free_function_indices_by_name_.find(
+        hash_name(name.data(), name.size()), [this, name](std::size_t index) {
+            return name == name_view_of(free_function_info_view_[index]);
+        });
+
+    if(found == hash_index::npos)
+    {
+        return const_free_function_iterator(free_function_info_view_.cend());
+    }
+
+    return const_free_function_iterator(free_function_info_view_.cbegin() +
+                                        found);
+}
+
 
 std::pair<reflection_manager::const_member_function_iterator,
           reflection_manager::const_member_function_iterator>
@@ -259,6 +582,12 @@ reflection_manager::member_function_name(const member_function_tag& tag) const
     return std::string(tag.info_ptr_->name);
 }
 
+string_view
+reflection_manager::member_function_name_view(const member_function_tag& tag) const
+{
+    return name_view_of(*tag.info_ptr_);
+}
+
 
 std::pair<reflection_manager::const_indexed_type_iterator,
           reflection_manager::const_indexed_type_iterator>
@@ -293,6 +622,85 @@ reflection_manager::call_member_function(object& obj,
                   this);
 }
 
+void
+reflection_manager::run_member_batch(const member_function_info& info,
+                                     object_vector& objects,
+                                     any* argument_array,
+                                     object_vector* results) const
+{
+    if(info.batch_bind_point == nullptr)
+    {
+        throw argument_error("member function has no batch trampoline");
+    }
+
+    if(!compare_type(objects.type(), info.object_type_index))
+    {
+        throw type_error("wrong class type for member function");
+    }
+
+    void* result_data = nullptr;
+
+    if(results != nullptr)
+    {
+        if(!compare_type(results->type(), info.return_type_index))
+        {
+            throw type_error("results don't hold the return type");
+        }
+
+        if(results->size() != objects.size())
+        {
+            throw argument_error("results differ in size from objects");
+        }
+
+        result_data = results->data();
+    }
+
+    info.batch_bind_point(
+        objects.data(), objects.size(), argument_array, result_data);
+}
+
+hash_index
+reflection_manager::index_member_function_names() const
+{
+    hash_index out(member_function_info_view_.size());
+
+    for(std::size_t index = 0; index < member_function_info_view_.size();
+        ++index)
+    {
+        const auto& info = member_function_info_view_[index];
+        const auto name = name_view_of(info);
+        out.insert(combine_hash(info.object_type_index,
+                                hash_name(name.data(), name.size())),
+                   index);
+    }
+
+    return out;
+}
+
+reflection_manager::const_member_function_iterator
+reflection_manager::find_member_function(const type_tag& tag,
+                                         string_view name) const
+{
+    const auto type_index = index_of_type(tag);
+
+    const auto found = member_function_indices_by_name_.find(
+        combine_hash(type_index, hash_name(name.data(), name.size())),
+        [this, type_index, name](std::size_t index) {
+            const auto& info = member_function_info_view_[index];
+            return info.object_type_index == type_index &&
+                   name == name_view_of(info);
+        });
+
+    if(found == hash_index::npos)
+    {
+        return const_member_function_iterator(
+            member_function_info_view_.cend());
+    }
+
+    return const_member_function_iterator(member_function_info_view_.cbegin() +
+                                          found);
+}
+
 
 std::pair<reflection_manager::const_member_variable_iterator,
           reflection_manager::const_member_variable_iterator>
@@ -336,24 +744,37 @@ reflection_manager::member_variable_class_type(
 }
 
 
+std::size_t
+reflection_manager::member_variable_offset(const member_variable_tag& tag) const
+{
+    return tag.info_ptr_->offset;
+}
+
+
 std::string
 reflection_manager::member_variable_name(const member_variable_tag& tag) const
 {
     return std::string(tag.info_ptr_->name);
 }
 
+string_view
+reflection_manager::member_variable_name_view(const member_variable_tag& tag) const
+{
+    return name_view_of(*tag.info_ptr_);
+}
+
 
 void
 reflection_manager::set_member_variable(object& obj,
                                         const member_variable_tag& tag,
                                         const object& val) const
 {
-    if(val.type() != member_variable_type(tag))
+    if(!object_has_type(val, tag.info_ptr_->type_index))
     {
         throw type_error("attempting to set member variable of wrong type");
     }
 
-    if(obj.type() != member_variable_class_type(tag))
+    if(!object_has_type(obj, tag.info_ptr_->object_type_index))
     {
         throw type_error(
             "attempting to set member variable belonging to wrong class");
@@ -367,7 +788,7 @@ object
 reflection_manager::get_member_variable(const object& obj,
                                         const member_variable_tag& tag) const
 {
-    if(obj.type() != member_variable_class_type(tag))
+    if(!object_has_type(obj, tag.info_ptr_->object_type_index))
     {
         throw type_error(
             "attempting to get member variable belonging to wrong class");
@@ -377,4 +798,407 @@ reflection_manager::get_member_variable(const object& obj,
                   type_info_view_.data() + tag.info_ptr_->type_index,
                   this);
 }
+
+
+member_reference
+reflection_manager::member_variable_reference(
+    object& obj, const member_variable_tag& tag) const
+{
+    if(!object_has_type(obj, tag.info_ptr_->object_type_index))
+    {
+        throw type_error(
+            "attempting to reference member variable belonging to wrong class");
+    }
+
+    if(!type_info_view_[tag.info_ptr_->object_type_index].standard_layout)
+    {
+        throw type_error(
+            "member variables can only be referenced in standard layout "
+            "classes");
+    }
+
+    return member_reference(static_cast<char*>(obj.value_.data()) +
+                                tag.info_ptr_->offset,
+                            type_info_view_.data() +
+                                tag.info_ptr_->type_index);
+}
+
+const_member_reference
+reflection_manager::member_variable_reference(
+    const object& obj, const member_variable_tag& tag) const
+{
+    if(!object_has_type(obj, tag.info_ptr_->object_type_index))
+    {
+        throw type_error(
+            "attempting to reference member variable belonging to wrong class");
+    }
+
+    if(!type_info_view_[tag.info_ptr_->object_type_index].standard_layout)
+    {
+        throw type_error(
+            "member variables can only be referenced in standard layout "
+            "classes");
+    }
+
+    return const_member_reference(static_cast<const char*>(obj.value_.data()) +
+                                      tag.info_ptr_->offset,
+                                  type_info_view_.data() +
+                                      tag.info_ptr_->type_index);
+}
+
+
+void
+reflection_manager::set_member_reference(const member_reference& ref,
+                                         const object& val) const
+{
+    // the reference may come from another manager, so its type_info doesn't
+    // necessarily point into type_info_view_
+    const auto type_index = find_index_of_type(ref.type());
+
+    if(type_index == hash_index::npos || !object_has_type(val, type_index))
+    {
+        throw type_error("attempting to set member reference of wrong type");
+    }
+
+    if(ref.type_info_->assign_bind_point == nullptr)
+    {
+        throw type_error("attempting to set member reference of type that "
+                         "can't be assigned");
+    }
+
+    ref.type_info_->assign_bind_point(ref.address_, val.value_.data());
+}
+
+hash_index
+reflection_manager::index_member_variable_names() const
+{
+    hash_index out(member_variable_info_view_.size());
+
+    for(std::size_t index = 0; index < member_variable_info_view_.size();
+        ++index)
+    {
+        const auto& info = member_variable_info_view_[index];
+        const auto name = name_view_of(info);
+        out.insert(combine_hash(info.object_type_index,
+                                hash_name(name.data(), name.size())),
+                   index);
+    }
+
+    return out;
+}
+
+reflection_manager::const_member_variable_iterator
+reflection_manager::find_member_variable(const type_tag& tag,
+                                         string_view name) const
+{
+    const auto type_index = index_of_type(tag);
+
+    const auto found = member_variable_indices_by_name_.find(
+        combine_hash(type_index, hash_name(name.data(), name.size())),
+        [this, type_index, name](std::size_t index) {
+            const auto& info = member_variable_info_view_[index];
+            return info.object_type_index == type_index &&
+                   name == name_view_of(info);
+        });
+
+    if(found == hash_index::npos)
+    {
+        return const_member_variable_iterator(
+            member_variable_info_view_.cend());
+    }
+
+    return const_member_variable_iterator(member_variable_info_view_.cbegin() +
+                                          found);
+}
+
+
+void
+reflection_manager::serialize_binary(const object& obj,
+                                     std::vector<char>& buffer) const
+{
+    write_binary(plan_for(index_of_object(obj)), obj.value_.data(), buffer);
+}
+
+
+const char*
+reflection_manager::deserialize_binary(object& obj,
+                                       const char* first,
+                                       const char* last) const
+{
+    return read_binary(
+        plan_for(index_of_object(obj)), obj.value_.data(), first, last);
+}
+
+
+void
+reflection_manager::write_binary(const serialization_plan& plan,
+                                 const void* value,
+                                 std::vector<char>& buffer) const
+{
+    for(const auto& step : plan.steps)
+    {
+        if(step.leaf == nullptr)
+        {
+            continue;
+        }
+
+        if(step.leaf->binary_serialization_bind_point == nullptr)
+        {
+            throw serialization_error("type has no binary serialization");
+        }
+
+        step.leaf->binary_serialization_bind_point(
+            buffer, static_cast<const char*>(value) + step.offset);
+    }
+}
+
+
+const char*
+reflection_manager::read_binary(const serialization_plan& plan,
+                                void* value,
+                                const char* first,
+                                const char* last) const
+{
+    for(const auto& step : plan.steps)
+    {
+        if(step.leaf == nullptr)
+        {
+            continue;
+        }
+
+        if(step.leaf->binary_deserialization_bind_point == nullptr)
+        {
+            throw serialization_error("type has no binary serialization");
+        }
+
+        first = step.leaf->binary_deserialization_bind_point(
+            first, last, static_cast<char*>(value) + step.offset);
+    }
+
+    return first;
+}
+
+
+void
+reflection_manager::serialize_text(const object& obj,
+                                   std::vector<char>& buffer) const
+{
+    const auto& plan = plan_for(index_of_object(obj));
+
+    buffer.resize(append_text(plan, obj.value_.data(), buffer, buffer.size()));
+}
+
+
+char*
+reflection_manager::serialize_text(const object& obj,
+                                   char* first,
+                                   char* last) const
+{
+    const auto end = write_text(
+        plan_for(index_of_object(obj)), obj.value_.data(), first, last);
+
+    if(end == nullptr)
+    {
+        throw serialization_error("text doesn't fit in buffer");
+    }
+
+    return end;
+}
+
+
+std::size_t
+reflection_manager::append_text(const serialization_plan& plan,
+                                const void* value,
+                                std::vector<char>& buffer,
+                                std::size_t position) const
+{
+    // most leaf values and their prefixes fit in this, longer ones make the
+    // buffer grow below
+    const std::size_t estimate = 24 * (plan.steps.size() + 1);
+
+    if(buffer.size() - position < estimate)
+    {
+        buffer.resize(position + estimate);
+    }
+
+    for(;;)
+    {
+        const auto end = write_text(plan,
+                                    value,
+                                    buffer.data() + position,
+                                    buffer.data() + buffer.size());
+
+        if(end != nullptr)
+        {
+            return end - buffer.data();
+        }
+
+        buffer.resize(std::max(buffer.size() * 2, position + estimate));
+    }
+}
+
+
+char*
+reflection_manager::write_text(const serialization_plan& plan,
+                               const void* value,
+                               char* first,
+                               char* last) const
+{
+    for(const auto& step : plan.steps)
+    {
+        first = text_format::write_chars(
+            first, last, step.prefix.data(), step.prefix.size());
+
+        if(first == nullptr)
+        {
+            return nullptr;
+        }
+
+        if(step.leaf == nullptr)
+        {
+            continue;
+        }
+
+        if(step.leaf->text_serialization_bind_point == nullptr)
+        {
+            throw serialization_error("type has no buffer text serialization");
+        }
+
+        first = step.leaf->text_serialization_bind_point(
+            first, last, static_cast<const char*>(value) + step.offset);
+
+        if(first == nullptr)
+        {
+            return nullptr;
+        }
+    }
+
+    return first;
+}
+
+
+const serialization_plan&
+reflection_manager::plan_for(std::size_t type_index) const
+{
+    return serialization_plans_.get(
+        type_index, [this, type_index]() { return make_plan(type_index); });
+}
+
+
+serialization_plan
+reflection_manager::make_plan(std::size_t type_index) const
+{
+    serialization_plan plan;
+    std::string prefix;
+
+    append_steps(type_index, 0, prefix, plan);
+
+    // closing braces after the last leaf value
+    if(!prefix.empty())
+    {
+        plan.steps.push_back(serialization_step{prefix, 0, nullptr});
+    }
+
+    return plan;
+}
+
+
+void
+reflection_manager::append_steps(std::size_t type_index,
+                                 std::size_t offset,
+                                 std::string& prefix,
+                                 serialization_plan& plan) const
+{
+    const auto info = default_serialization_by_type_[type_index];
+
+    if(info != nullptr)
+    {
+        plan.steps.push_back(serialization_step{prefix, offset, info});
+        prefix.clear();
+        return;
+    }
+
+    // steps address member variables by offset, which is only well defined
+    // in standard layout classes
+    if(!type_info_view_[type_index].standard_layout)
+    {
+        throw serialization_error(
+            "type without serialization isn't a standard layout class");
+    }
+
+    // nested types are flattened, their punctuation merged into the prefix of
+    // the next leaf value
+    prefix += '{';
+
+    const auto& schema = schemas_by_type_[type_index];
+    for(auto it = schema.begin(); it != schema.end(); ++it)
+    {
+        if(it != schema.begin())
+        {
+            prefix += ", ";
+        }
+
+        append_steps(it->type_index, offset + it->offset, prefix, plan);
+    }
+
+    prefix += '}';
+}
+
+
+const char*
+reflection_manager::deserialize_text(object& obj,
+                                     const char* first,
+                                     const char* last) const
+{
+    return read_text(index_of_object(obj), obj.value_.data(), first, last);
+}
+
+
+const char*
+reflection_manager::read_text(std::size_t type_index,
+                              void* value,
+                              const char* first,
+                              const char* last) const
+{
+    const auto info = default_serialization_by_type_[type_index];
+
+    if(info != nullptr)
+    {
+        if(info->text_deserialization_bind_point == nullptr)
+        {
+            throw serialization_error("type has no buffer text serialization");
+        }
+
+        return info->text_deserialization_bind_point(first, last, value);
+    }
+
+    if(!type_info_view_[type_index].standard_layout)
+    {
+        throw serialization_error(
+            "type without serialization isn't a standard layout class");
+    }
+
+    first = text_format::read_char(first, last, '{');
+
+    const auto& mv_indices = member_variable_indices_by_type_[type_index];
+    for(auto it = mv_indices.begin(); it != mv_indices.end(); ++it)
+    {
+        const auto& mv_info = member_variable_info_view_[*it];
+
+        if(it != mv_indices.begin())
+        {
+            first = text_format::read_char(first, last, ',');
+        }
+
+        // members are registered with offsetof, and the class is standard
+        // layout, so their address is known without going through the get
+        // and set bind points
+        first = read_text(mv_info.type_index,
+                          static_cast<char*>(value) + mv_info.offset,
+                          first,
+                          last);
+    }
+
+    return text_format::read_char(first, last, '}');
+}
 }
@@ -1,6 +1,7 @@
 #include "catch.hpp"
 
 #include <any.hpp>
+#include <string>
 #include <vector>
 
 
@@ -106,3 +107,257 @@ TEST_CASE("std::vector of any", "[any]")
         REQUIRE(any_vec.front().get<double>() == 23.5);
     }
 }
+
+
+struct large_value
+{
+    char buffer[SHADOW_ANY_BUFFER_SIZE + 1];
+};
+
+
+TEST_CASE("small buffer storage of any", "[any]")
+{
+    SECTION("fundamental types are held inline")
+    {
+        CHECK(shadow::any(10).on_heap() == false);
+        CHECK(shadow::any(10.5).on_heap() == false);
+        CHECK(shadow::any(static_cast<long double>(10.5)).on_heap() == false);
+    }
+
+    SECTION("std::string and std::vector are held inline")
+    {
+        CHECK(shadow::any(std::string("hello")).on_heap() == false);
+        CHECK(shadow::any(std::vector<int>{1, 2, 3}).on_heap() == false);
+    }
+
+    SECTION("values larger than the buffer are held on the heap")
+    {
+        CHECK(shadow::any(large_value()).on_heap() == true);
+    }
+
+    SECTION("copy, move and swap inline std::string")
+    {
+        shadow::any a(std::string("a string long enough to not use sso"));
+        shadow::any b(std::string("short"));
+
+        shadow::any c(a);
+        REQUIRE(c.get<std::string>() == a.get<std::string>());
+
+        shadow::any d(std::move(c));
+        REQUIRE(d.get<std::string>() ==
+                std::string("a string long enough to not use sso"));
+        REQUIRE(c.has_value() == false);
+
+        d.swap(b);
+        REQUIRE(b.get<std::string>() ==
+                std::string("a string long enough to not use sso"));
+        REQUIRE(d.get<std::string>() == std::string("short"));
+
+        shadow::any e(large_value{});
+        e.swap(d);
+        REQUIRE(e.get<std::string>() == std::string("short"));
+        REQUIRE(d.on_heap() == true);
+    }
+}
+
+
+TEST_CASE("type identity of value held by any", "[any]")
+{
+    shadow::any a(10);
+    shadow::any b(std::string("hello"));
+    shadow::any c;
+
+    CHECK(a.has_type<int>());
+    CHECK(a.has_type<const int&>());
+    CHECK(!a.has_type<unsigned int>());
+    CHECK(b.has_type<std::string>());
+    CHECK(!c.has_type<int>());
+
+    SECTION("type follows the value on copy and move")
+    {
+        c = a;
+        CHECK(c.has_type<int>());
+
+        shadow::any d(std::move(b));
+        CHECK(d.has_type<std::string>());
+        CHECK(!b.has_value());
+    }
+}
+
+
+// records how it was constructed and keeps a pointer to itself, like a
+// std::string with a short string optimization
+struct self_referencing
+{
+    self_referencing() : self(this)
+    {
+    }
+
+    self_referencing(const self_referencing&) : self(this), copied(true)
+    {
+    }
+
+    self_referencing(self_referencing&&) noexcept : self(this), moved(true)
+    {
+    }
+
+    self_referencing* self;
+    bool copied = false;
+    bool moved = false;
+};
+
+// move constructor isn't noexcept, so it is only held inline because it is
+// declared trivially relocatable below
+struct relocatable_value
+{
+    relocatable_value() = default;
+
+    relocatable_value(const relocatable_value&) = default;
+
+    relocatable_value(relocatable_value&& other)
+        : value(other.value), moves(other.moves + 1)
+    {
+    }
+
+    int value = 0;
+    int moves = 0;
+};
+
+struct throwing_move
+{
+    throwing_move() = default;
+
+    throwing_move(const throwing_move&)
+    {
+    }
+};
+
+namespace shadow
+{
+template <>
+struct is_trivially_relocatable<relocatable_value> : std::true_type
+{
+};
+}
+
+
+TEST_CASE("move semantics of any", "[any]")
+{
+    static_assert(std::is_nothrow_move_constructible<shadow::any>::value,
+                  "moving an any should never throw");
+    static_assert(std::is_nothrow_move_assignable<shadow::any>::value,
+                  "moving an any should never throw");
+
+    SECTION("inline values are moved with their move constructor")
+    {
+        shadow::any a{self_referencing()};
+        shadow::any b(std::move(a));
+
+        REQUIRE(b.on_heap() == false);
+        REQUIRE(b.get<self_referencing>().moved);
+        REQUIRE(b.get<self_referencing>().copied == false);
+        REQUIRE(b.get<self_referencing>().self == &b.get<self_referencing>());
+
+        shadow::any c;
+        c = std::move(b);
+
+        REQUIRE(c.get<self_referencing>().self == &c.get<self_referencing>());
+    }
+
+    SECTION("copies of inline values are still made with the copy constructor")
+    {
+        shadow::any a{self_referencing()};
+        shadow::any b(a);
+
+        REQUIRE(b.get<self_referencing>().copied);
+        REQUIRE(b.get<self_referencing>().self == &b.get<self_referencing>());
+    }
+
+    SECTION("trivially relocatable values are moved by copying bytes")
+    {
+        relocatable_value value;
+        value.value = 42;
+
+        shadow::any a(std::move(value));
+        REQUIRE(a.get<relocatable_value>().moves == 1);
+
+        shadow::any b(std::move(a));
+
+        REQUIRE(b.on_heap() == false);
+        REQUIRE(b.get<relocatable_value>().value == 42);
+        REQUIRE(b.get<relocatable_value>().moves == 1);
+    }
+
+    SECTION("values that might throw when moved are held on the heap")
+    {
+        shadow::any a{throwing_move()};
+
+        REQUIRE(a.on_heap() == true);
+    }
+
+    SECTION("vector of any reallocates by moving")
+    {
+        std::vector<shadow::any> any_vec;
+        any_vec.emplace_back(self_referencing());
+
+        for(int i = 0; i < 100; ++i)
+        {
+            any_vec.emplace_back(i);
+        }
+
+        REQUIRE(any_vec.front().get<self_referencing>().copied == false);
+        REQUIRE(any_vec.front().get<self_referencing>().self ==
+                &any_vec.front().get<self_referencing>());
+    }
+}
+
+
+TEST_CASE("any referring to a value held elsewhere", "[any]")
+{
+    std::string value("referenced");
+
+    auto ref = shadow::any::reference_to(
+        &value, &shadow::any_operations_for<std::string>::value);
+
+    REQUIRE(ref.is_reference());
+    REQUIRE(ref.has_value());
+    REQUIRE(ref.has_type<std::string>());
+    REQUIRE(ref.data() == &value);
+
+    SECTION("access in place")
+    {
+        ref.get<std::string>() += " value";
+
+        REQUIRE(value == "referenced value");
+    }
+
+    SECTION("moves keep referring to the value")
+    {
+        shadow::any moved(std::move(ref));
+
+        REQUIRE(moved.is_reference());
+        REQUIRE(moved.data() == &value);
+    }
+
+    SECTION("copies hold their own value")
+    {
+        shadow::any copy(ref);
+
+        REQUIRE(copy.is_reference() == false);
+        REQUIRE(copy.on_heap());
+        REQUIRE(copy.data() != &value);
+
+        copy.get<std::string>() = "copy";
+        REQUIRE(value == "referenced");
+    }
+
+    SECTION("destroying the reference leaves the value")
+    {
+        {
+            auto other = shadow::any::reference_to(
+                &value, &shadow::any_operations_for<std::string>::value);
+        }
+
+        REQUIRE(value == "referenced");
+    }
+}
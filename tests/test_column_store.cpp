@@ -0,0 +1,187 @@
+#include "catch.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <shadow.hpp>
+#include <column_store.hpp>
+
+
+struct tcs_particle
+{
+    double x;
+    double y;
+    int id;
+    char tag;
+};
+
+struct tcs_pair
+{
+    int first;
+    int second;
+};
+
+struct tcs_named
+{
+    int id;
+    std::string name;
+};
+
+
+namespace tcs_space
+{
+REGISTER_TYPE_BEGIN()
+REGISTER_TYPE(tcs_particle)
+REGISTER_TYPE(tcs_pair)
+REGISTER_TYPE(tcs_named)
+REGISTER_TYPE_END()
+
+REGISTER_CONSTRUCTOR(tcs_particle)
+
+REGISTER_MEMBER_VARIABLE(tcs_particle, x)
+REGISTER_MEMBER_VARIABLE(tcs_particle, y)
+REGISTER_MEMBER_VARIABLE(tcs_particle, id)
+REGISTER_MEMBER_VARIABLE(tcs_particle, tag)
+REGISTER_MEMBER_VARIABLE(tcs_pair, first)
+REGISTER_MEMBER_VARIABLE(tcs_pair, second)
+REGISTER_MEMBER_VARIABLE(tcs_named, id)
+REGISTER_MEMBER_VARIABLE(tcs_named, name)
+
+SHADOW_INIT()
+} // namespace tcs_space
+
+
+namespace
+{
+shadow::type_tag
+particle_type()
+{
+    return tcs_space::static_construct<tcs_particle>().type();
+}
+
+shadow::member_variable_tag
+particle_field(const char* name)
+{
+    return *tcs_space::manager.find_member_variable(particle_type(), name);
+}
+} // namespace
+
+
+TEST_CASE("store objects by column", "[column_store]")
+{
+    shadow::column_store store(tcs_space::manager, particle_type());
+
+    REQUIRE(store.empty());
+    REQUIRE(store.type() == particle_type());
+
+    store.reserve(10);
+    for(int i = 0; i < 10; ++i)
+    {
+        store.push_back(tcs_space::static_make_object(
+            tcs_particle{i * 1.0, i * 2.0, i, char('a' + i)}));
+    }
+
+    REQUIRE(store.size() == 10);
+
+    SECTION("scan a column")
+    {
+        const auto& const_store = store;
+        const auto ys = const_store.column<double>(particle_field("y"));
+
+        REQUIRE(ys.second - ys.first == 10);
+        REQUIRE(std::accumulate(ys.first, ys.second, 0.0) == Approx(90.0));
+
+        const auto ids = const_store.column<int>(particle_field("id"));
+        REQUIRE(ids.first[7] == 7);
+
+        const auto tags = const_store.column<char>(particle_field("tag"));
+        REQUIRE(tags.first[3] == 'd');
+    }
+
+    SECTION("update a column in place")
+    {
+        const auto xs = store.column<double>(particle_field("x"));
+        std::for_each(xs.first, xs.second, [](double& x) { x *= 10.0; });
+
+        const auto row = store.row(4);
+        const auto& p = tcs_space::get_held_value<tcs_particle>(row);
+
+        REQUIRE(p.x == Approx(40.0));
+        REQUIRE(p.y == Approx(8.0));
+    }
+
+    SECTION("reconstruct rows")
+    {
+        const auto row = store.row(9);
+
+        REQUIRE(row.type() == particle_type());
+
+        const auto& p = tcs_space::get_held_value<tcs_particle>(row);
+        REQUIRE(p.x == Approx(9.0));
+        REQUIRE(p.y == Approx(18.0));
+        REQUIRE(p.id == 9);
+        REQUIRE(p.tag == 'j');
+
+        REQUIRE_THROWS_AS(store.row(10), shadow::argument_error);
+    }
+
+    SECTION("clear")
+    {
+        store.clear();
+
+        REQUIRE(store.empty());
+        REQUIRE(store.column<int>(particle_field("id")).first ==
+                store.column<int>(particle_field("id")).second);
+    }
+
+    SECTION("mismatching types")
+    {
+        REQUIRE_THROWS_AS(store.column<int>(particle_field("x")),
+                          shadow::type_error);
+
+        // same size as the member variable, but a different type
+        REQUIRE_THROWS_AS(store.column<float>(particle_field("id")),
+                          shadow::type_error);
+        REQUIRE_THROWS_AS(store.column<long long>(particle_field("x")),
+                          shadow::type_error);
+
+        REQUIRE_THROWS_AS(
+            store.push_back(tcs_space::static_make_object(tcs_pair{1, 2})),
+            shadow::type_error);
+
+        const auto pair_type = tcs_space::static_construct<tcs_pair>().type();
+        const auto first =
+            *tcs_space::manager.find_member_variable(pair_type, "first");
+
+        REQUIRE_THROWS_AS(store.column<int>(first), shadow::type_error);
+    }
+}
+
+
+TEST_CASE("column_store requirements", "[column_store]")
+{
+    SECTION("member variables must be trivially copyable")
+    {
+        const auto named_type =
+            tcs_space::static_construct<tcs_named>().type();
+
+        REQUIRE_THROWS_AS(
+            shadow::column_store(tcs_space::manager, named_type),
+            shadow::type_error);
+    }
+
+    SECTION("rows need a default constructor")
+    {
+        const auto pair_type = tcs_space::static_construct<tcs_pair>().type();
+
+        shadow::column_store store(tcs_space::manager, pair_type);
+        store.push_back(tcs_space::static_make_object(tcs_pair{1, 2}));
+
+        REQUIRE(store.column<int>(*tcs_space::manager.find_member_variable(
+                                      pair_type, "second"))
+                    .first[0] == 2);
+        REQUIRE_THROWS_AS(store.row(0), shadow::type_error);
+    }
+}
@@ -1,9 +1,18 @@
 #include "catch.hpp"
 
 #include <shadow.hpp>
+#include <object_vector.hpp>
 #include <sstream>
 #include <vector>
 #include <algorithm>
+#include <thread>
+#include <limits>
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#include <cmath>
+#include <string>
+#include <memory>
 
 
 class tct1_class
@@ -56,6 +65,12 @@ struct tct1_struct2
     tct1_struct the_struct;
 };
 
+struct tct1_labelled
+{
+    std::string label;
+    int value;
+};
+
 int
 extract_i(const tct1_class& a)
 {
@@ -87,6 +102,100 @@ make_number()
     return 4248;
 }
 
+int
+sum_many(int a, int b, int c, int d, int e, int f, int g, int h, int i, int j)
+{
+    return a + b + c + d + e + f + g + h + i + j;
+}
+
+std::string
+repeat(const std::string& str, int times)
+{
+    std::string out;
+    for(int i = 0; i < times; ++i)
+    {
+        out += str;
+    }
+
+    return out;
+}
+
+std::size_t
+length_of(const char* str)
+{
+    return std::strlen(str);
+}
+
+int batch_kernel_calls = 0;
+
+int
+add_ints(int a, int b)
+{
+    return a + b;
+}
+
+void
+add_ints_kernel(int* results, const int* a, const int* b, std::size_t rows)
+{
+    ++batch_kernel_calls;
+
+    for(std::size_t row = 0; row < rows; ++row)
+    {
+        results[row] = a[row] + b[row];
+    }
+}
+
+void
+twice(int& i)
+{
+    i *= 2;
+}
+
+void
+twice_kernel(int* values, std::size_t rows)
+{
+    ++batch_kernel_calls;
+
+    for(std::size_t row = 0; row < rows; ++row)
+    {
+        values[row] *= 2;
+    }
+}
+
+void
+halve(int& i)
+{
+    i /= 2;
+}
+
+void
+halve(double& d)
+{
+    d /= 2.0;
+}
+
+void
+halve_kernel(int* values, std::size_t rows)
+{
+    ++batch_kernel_calls;
+
+    for(std::size_t row = 0; row < rows; ++row)
+    {
+        values[row] /= 2;
+    }
+}
+
+void
+halve_kernel(double* values, std::size_t rows)
+{
+    ++batch_kernel_calls;
+
+    for(std::size_t row = 0; row < rows; ++row)
+    {
+        values[row] /= 2.0;
+    }
+}
+
 namespace tct1_space
 {
 REGISTER_TYPE_BEGIN()
@@ -146,6 +255,51 @@ REGISTER_MEMBER_VARIABLE(tct1_struct2, the_struct)
 SHADOW_INIT()
 }
 
+
+namespace tct1_space4
+{
+REGISTER_TYPE_BEGIN()
+REGISTER_TYPE_END()
+
+REGISTER_FREE_FUNCTION(triple)
+REGISTER_FREE_FUNCTION(sum_many)
+
+SHADOW_INIT()
+}
+
+namespace tct1_space5
+{
+REGISTER_TYPE_BEGIN()
+REGISTER_TYPE_END()
+
+REGISTER_FREE_FUNCTION(triple)
+REGISTER_FREE_FUNCTION(modify)
+REGISTER_FREE_FUNCTION(make_number)
+REGISTER_FREE_FUNCTION(sum_many)
+REGISTER_FREE_FUNCTION(repeat)
+REGISTER_FREE_FUNCTION(length_of)
+REGISTER_FREE_FUNCTION_WITH_BATCH_KERNEL(add_ints, add_ints_kernel)
+REGISTER_FREE_FUNCTION_WITH_BATCH_KERNEL(twice, twice_kernel)
+REGISTER_FREE_FUNCTION_EXPLICIT_WITH_BATCH_KERNEL(halve,
+                                                  halve_kernel,
+                                                  void,
+                                                  double&)
+
+SHADOW_INIT()
+}
+
+namespace tct1_space6
+{
+REGISTER_TYPE_BEGIN()
+REGISTER_TYPE(tct1_labelled)
+REGISTER_TYPE_END()
+
+REGISTER_MEMBER_VARIABLE(tct1_labelled, label)
+REGISTER_MEMBER_VARIABLE(tct1_labelled, value)
+
+SHADOW_INIT()
+}
+
 TEST_CASE("create an int using static_construct", "[static_construct]")
 {
     auto anint = tct1_space::static_construct<int>(23);
@@ -1059,3 +1213,1411 @@ TEST_CASE("call free function taking no arguments",
         REQUIRE(tct1_space::get_held_value<int>(res) == 4248);
     }
 }
+
+
+TEST_CASE("call free functions with few and many arguments",
+          "[reflection_manager::call_free_function]")
+{
+    const auto& manager = tct1_space4::manager;
+
+    auto funs = manager.free_functions();
+
+    SECTION("call function with arguments held on the stack")
+    {
+        auto found = std::find_if(funs.first, funs.second, [](const auto& ff) {
+            return ff.name() == std::string("triple");
+        });
+
+        REQUIRE(found != funs.second);
+
+        shadow::object args[] = {tct1_space4::static_make_object(5)};
+
+        manager.call_free_function(*found, std::begin(args), std::end(args));
+
+        REQUIRE(tct1_space4::get_held_value<int>(args[0]) == 15);
+    }
+
+    SECTION("call function with more arguments than held on the stack")
+    {
+        auto found = std::find_if(funs.first, funs.second, [](const auto& ff) {
+            return ff.name() == std::string("sum_many");
+        });
+
+        REQUIRE(found != funs.second);
+
+        std::vector<shadow::object> args;
+        for(int i = 1; i <= 10; ++i)
+        {
+            args.push_back(tct1_space4::static_make_object(i));
+        }
+
+        auto res = manager.call_free_function(*found, args.begin(), args.end());
+
+        REQUIRE(tct1_space4::get_held_value<int>(res) == 55);
+    }
+}
+
+
+TEST_CASE("find functions and member variables by name",
+          "[reflection_manager::find_free_function]")
+{
+    SECTION("find free functions")
+    {
+        const auto& manager = tct1_space2::manager;
+        const auto end = manager.free_functions().second;
+
+        auto found = manager.find_free_function("triple");
+        REQUIRE(found != end);
+        REQUIRE(found->name() == std::string("triple"));
+
+        const std::string name = "modify";
+        found = manager.find_free_function(name);
+        REQUIRE(found != end);
+        REQUIRE(found->name() == name);
+
+        // prefix of a registered name isn't a match
+        REQUIRE(manager.find_free_function(shadow::string_view("mult", 3)) ==
+                end);
+        REQUIRE(manager.find_free_function("nothing") == end);
+        REQUIRE(manager.find_free_function(shadow::string_view()) == end);
+    }
+
+    SECTION("compare empty views")
+    {
+        const shadow::string_view empty;
+
+        REQUIRE(empty == "");
+        REQUIRE(empty != "a");
+        REQUIRE(empty == shadow::string_view("", 0));
+        REQUIRE(empty != shadow::string_view("a"));
+    }
+
+    SECTION("compare views with null terminated strings")
+    {
+        const shadow::string_view mult("multiply", 4);
+
+        REQUIRE(mult == "mult");
+        REQUIRE(mult != "mul");
+        REQUIRE(mult != "multiply");
+        REQUIRE(mult != "mulx");
+        REQUIRE(shadow::string_view("a\0b", 3) != "a");
+    }
+
+    SECTION("find member functions of a class type")
+    {
+        const auto& manager = tct1_space2::manager;
+        const auto end = manager.member_functions().second;
+        auto obj = tct1_space2::static_construct<tct1_class>(3);
+
+        auto found = manager.find_member_function(obj.type(), "set_i");
+        REQUIRE(found != end);
+        REQUIRE(found->name() == std::string("set_i"));
+
+        found = manager.find_member_function(obj.type(), "get_i");
+        REQUIRE(found != end);
+        REQUIRE(manager.call_member_function(obj, *found).type().name() ==
+                std::string("int"));
+
+        REQUIRE(manager.find_member_function(obj.type(), "i_") == end);
+    }
+
+    SECTION("find member variables of a class type")
+    {
+        const auto& manager = tct1_space3::manager;
+        const auto end = manager.member_variables().second;
+        auto s = tct1_space3::static_construct<tct1_struct>();
+        auto s2 = tct1_space3::static_construct<tct1_struct2>();
+
+        auto found = manager.find_member_variable(s.type(), "d");
+        REQUIRE(found != end);
+        REQUIRE(found->name() == std::string("d"));
+        REQUIRE(manager.member_variable_class_type(*found) == s.type());
+
+        found = manager.find_member_variable(s2.type(), "index");
+        REQUIRE(found != end);
+        REQUIRE(manager.member_variable_class_type(*found) == s2.type());
+
+        // name registered for another class type only
+        REQUIRE(manager.find_member_variable(s2.type(), "d") == end);
+    }
+}
+
+
+TEST_CASE("call free functions by name and argument types",
+          "[reflection_manager::call_free_function]")
+{
+    const auto& manager = tct1_space4::manager;
+
+    std::vector<shadow::object> args;
+    for(int i = 1; i <= 10; ++i)
+    {
+        args.push_back(tct1_space4::static_make_object(i));
+    }
+
+    SECTION("repeated calls resolve to the same function")
+    {
+        for(int i = 0; i < 3; ++i)
+        {
+            auto res =
+                manager.call_free_function("sum_many", args.begin(), args.end());
+
+            REQUIRE(tct1_space4::get_held_value<int>(res) == 55);
+        }
+    }
+
+    SECTION("out parameters are passed back when resolved by name")
+    {
+        shadow::object arg[] = {tct1_space4::static_make_object(4)};
+
+        manager.call_free_function("triple", std::begin(arg), std::end(arg));
+        manager.call_free_function("triple", std::begin(arg), std::end(arg));
+
+        REQUIRE(tct1_space4::get_held_value<int>(arg[0]) == 36);
+    }
+
+    SECTION("no function with the name")
+    {
+        REQUIRE_THROWS_AS(
+            manager.call_free_function("sum_few", args.begin(), args.end()),
+            shadow::argument_error);
+    }
+
+    SECTION("no function with the argument types")
+    {
+        // resolve once so that a cached entry exists for the name
+        manager.call_free_function("sum_many", args.begin(), args.end());
+
+        REQUIRE_THROWS_AS(manager.call_free_function(
+                              "sum_many", args.begin(), args.begin() + 9),
+                          shadow::argument_error);
+
+        shadow::object arg[] = {tct1_space4::static_make_object(4.0)};
+
+        REQUIRE_THROWS_AS(
+            manager.call_free_function("triple", std::begin(arg), std::end(arg)),
+            shadow::argument_error);
+    }
+
+    SECTION("arguments of unregistered types")
+    {
+        // tct1_space4 doesn't register tct1_struct
+        shadow::object arg[] = {tct1_space::static_construct<tct1_struct>(1)};
+
+        REQUIRE_THROWS_AS(
+            manager.call_free_function("triple", std::begin(arg), std::end(arg)),
+            shadow::argument_error);
+    }
+
+    SECTION("calls from several threads")
+    {
+        std::vector<int> sums(4, 0);
+        std::vector<std::thread> threads;
+
+        for(auto& sum : sums)
+        {
+            threads.emplace_back([&manager, &sum, args]() mutable {
+                for(int i = 0; i < 100; ++i)
+                {
+                    auto res = manager.call_free_function(
+                        "sum_many", args.begin(), args.end());
+                    sum += tct1_space4::get_held_value<int>(res);
+                }
+            });
+        }
+
+        for(auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        REQUIRE(std::all_of(sums.begin(), sums.end(), [](int sum) {
+            return sum == 5500;
+        }));
+    }
+}
+
+
+TEST_CASE("get names without allocating", "[reflection_manager::name_view]")
+{
+    SECTION("type names")
+    {
+        auto s = tct1_space3::static_construct<tct1_struct>();
+
+        REQUIRE(s.type().name_view() == "tct1_struct");
+        REQUIRE(tct1_space3::manager.type_name_view(s.type()).size() ==
+                std::string("tct1_struct").size());
+    }
+
+    SECTION("free function names")
+    {
+        const auto& manager = tct1_space2::manager;
+        auto funs = manager.free_functions();
+
+        std::for_each(funs.first, funs.second, [&manager](const auto& ff) {
+            REQUIRE(manager.free_function_name_view(ff).to_string() ==
+                    manager.free_function_name(ff));
+        });
+    }
+
+    SECTION("member function names")
+    {
+        const auto& manager = tct1_space2::manager;
+        auto mfs = manager.member_functions();
+
+        std::for_each(mfs.first, mfs.second, [&manager](const auto& mf) {
+            REQUIRE(manager.member_function_name_view(mf).to_string() ==
+                    manager.member_function_name(mf));
+        });
+    }
+
+    SECTION("member variable names")
+    {
+        const auto& manager = tct1_space3::manager;
+        auto mvs = manager.member_variables();
+
+        std::for_each(mvs.first, mvs.second, [&manager](const auto& mv) {
+            REQUIRE(mv.name_view() == manager.member_variable_name(mv));
+            REQUIRE(manager.member_variable_name_view(mv).size() ==
+                    manager.member_variable_name(mv).size());
+        });
+    }
+}
+
+
+TEST_CASE("binary serialization and deserialization",
+          "[reflection_manager::serialize_binary]")
+{
+    const auto& manager = tct1_space3::manager;
+    std::vector<char> buffer;
+
+    SECTION("int is written little endian")
+    {
+        auto obj = tct1_space3::static_make_object(0x01020304);
+        manager.serialize_binary(obj, buffer);
+
+        REQUIRE(buffer == std::vector<char>{4, 3, 2, 1});
+
+        auto read = tct1_space3::static_make_object(0);
+        auto end = manager.deserialize_binary(
+            read, buffer.data(), buffer.data() + buffer.size());
+
+        REQUIRE(end == buffer.data() + buffer.size());
+        REQUIRE(tct1_space3::get_held_value<int>(read) == 0x01020304);
+    }
+
+    SECTION("integers have the same width on every platform")
+    {
+        manager.serialize_binary(tct1_space3::static_make_object(-2L), buffer);
+        REQUIRE(buffer.size() == 8);
+        REQUIRE(buffer == std::vector<char>(
+                              {-2, -1, -1, -1, -1, -1, -1, -1}));
+
+        auto read = tct1_space3::static_make_object(0L);
+        manager.deserialize_binary(
+            read, buffer.data(), buffer.data() + buffer.size());
+        REQUIRE(tct1_space3::get_held_value<long>(read) == -2L);
+
+        buffer.clear();
+        manager.serialize_binary(tct1_space3::static_make_object(1UL), buffer);
+        manager.serialize_binary(
+            tct1_space3::static_make_object(static_cast<short>(1)), buffer);
+        manager.serialize_binary(tct1_space3::static_make_object(1LL), buffer);
+        REQUIRE(buffer.size() == 8 + 2 + 8);
+    }
+
+    SECTION("string is prefixed by its length")
+    {
+        auto obj = tct1_space3::static_make_object(std::string("abc"));
+        manager.serialize_binary(obj, buffer);
+
+        REQUIRE(buffer == std::vector<char>{3, 0, 0, 0, 'a', 'b', 'c'});
+
+        auto read = tct1_space3::static_make_object(std::string("longer"));
+        manager.deserialize_binary(
+            read, buffer.data(), buffer.data() + buffer.size());
+
+        REQUIRE(tct1_space3::get_held_value<std::string>(read) == "abc");
+    }
+
+    SECTION("bool and double round trip")
+    {
+        manager.serialize_binary(tct1_space3::static_make_object(true),
+                                 buffer);
+        manager.serialize_binary(tct1_space3::static_make_object(-0.1),
+                                 buffer);
+
+        REQUIRE(buffer.size() == 1 + sizeof(double));
+
+        auto b = tct1_space3::static_make_object(false);
+        auto d = tct1_space3::static_make_object(0.0);
+        auto pos = manager.deserialize_binary(
+            b, buffer.data(), buffer.data() + buffer.size());
+        manager.deserialize_binary(d, pos, buffer.data() + buffer.size());
+
+        REQUIRE(tct1_space3::get_held_value<bool>(b) == true);
+        REQUIRE(tct1_space3::get_held_value<double>(d) == -0.1);
+    }
+
+    SECTION("long double is written without its padding")
+    {
+        typedef std::numeric_limits<long double> limits;
+        const long double values[] = {-0.1L,
+                                      0.0L,
+                                      3.0L,
+                                      limits::max(),
+                                      limits::min(),
+                                      -limits::infinity()};
+
+        for(const auto value : values)
+        {
+            buffer.clear();
+            manager.serialize_binary(tct1_space3::static_make_object(value),
+                                     buffer);
+
+            REQUIRE(buffer.size() == 21);
+
+            auto read = tct1_space3::static_make_object(1.0L);
+            manager.deserialize_binary(
+                read, buffer.data(), buffer.data() + buffer.size());
+
+            REQUIRE(tct1_space3::get_held_value<long double>(read) == value);
+        }
+
+        // 3 is 0.75 * 2^2
+        buffer.clear();
+        manager.serialize_binary(tct1_space3::static_make_object(3.0L), buffer);
+        REQUIRE(buffer[0] == 0);
+        REQUIRE(buffer[1] == 2);
+        REQUIRE(static_cast<unsigned char>(buffer[12]) == 0xc0);
+
+        buffer.clear();
+        manager.serialize_binary(
+            tct1_space3::static_make_object(limits::quiet_NaN()), buffer);
+
+        auto nan = tct1_space3::static_make_object(0.0L);
+        manager.deserialize_binary(
+            nan, buffer.data(), buffer.data() + buffer.size());
+        REQUIRE(std::isnan(tct1_space3::get_held_value<long double>(nan)));
+    }
+
+    SECTION("nested structs are written inline")
+    {
+        auto obj = tct1_space3::static_construct<tct1_struct2>(
+            std::size_t(7), tct1_struct{-3, 2.5});
+        manager.serialize_binary(obj, buffer);
+
+        // std::size_t is an unsigned long, written as 8 bytes on every
+        // platform
+        REQUIRE(buffer.size() == 8 + 4 + 8);
+
+        auto read = tct1_space3::static_construct<tct1_struct2>();
+        manager.deserialize_binary(
+            read, buffer.data(), buffer.data() + buffer.size());
+
+        const auto& value = tct1_space3::get_held_value<tct1_struct2>(read);
+        REQUIRE(value.index == 7);
+        REQUIRE(value.the_struct.i == -3);
+        REQUIRE(value.the_struct.d == 2.5);
+
+        SECTION("buffer ending early")
+        {
+            REQUIRE_THROWS_AS(
+                manager.deserialize_binary(
+                    read, buffer.data(), buffer.data() + buffer.size() - 1),
+                shadow::serialization_error);
+        }
+    }
+}
+
+
+TEST_CASE("text serialization into char buffers",
+          "[reflection_manager::serialize_text]")
+{
+    const auto& manager = tct1_space3::manager;
+    std::vector<char> buffer;
+
+    auto text = [&buffer]() {
+        return std::string(buffer.begin(), buffer.end());
+    };
+
+    SECTION("integers")
+    {
+        manager.serialize_text(tct1_space3::static_make_object(-42), buffer);
+        REQUIRE(text() == "-42");
+
+        buffer.clear();
+        manager.serialize_text(
+            tct1_space3::static_make_object(std::numeric_limits<int>::min()),
+            buffer);
+        REQUIRE(text() == std::to_string(std::numeric_limits<int>::min()));
+    }
+
+    SECTION("floating point values use the shortest round trip text")
+    {
+        manager.serialize_text(tct1_space3::static_make_object(0.1), buffer);
+        REQUIRE(text() == "0.1");
+
+        buffer.clear();
+        const double third = 1.0 / 3.0;
+        manager.serialize_text(tct1_space3::static_make_object(third), buffer);
+        REQUIRE(std::strtod(text().c_str(), nullptr) == third);
+    }
+
+    SECTION("strings, chars and bools")
+    {
+        manager.serialize_text(
+            tct1_space3::static_make_object(std::string("abc")), buffer);
+        manager.serialize_text(tct1_space3::static_make_object('c'), buffer);
+        manager.serialize_text(tct1_space3::static_make_object(false), buffer);
+
+        REQUIRE(text() == "\"abc\"cfalse");
+    }
+
+    SECTION("text longer than the estimated size")
+    {
+        const std::string long_string(1000, 'x');
+        buffer.assign({'a', 'b'});
+        manager.serialize_text(tct1_space3::static_make_object(long_string),
+                               buffer);
+
+        REQUIRE(text() == "ab\"" + long_string + "\"");
+    }
+
+    SECTION("structs have the same format as operator<<")
+    {
+        auto obj = tct1_space3::static_construct<tct1_struct2>(
+            std::size_t(7), tct1_struct{-3, 2.5});
+        manager.serialize_text(obj, buffer);
+
+        std::ostringstream out;
+        out << obj;
+
+        REQUIRE(text() == "{7, {-3, 2.5}}");
+        REQUIRE(text() == out.str());
+
+        SECTION("appending to a buffer with text")
+        {
+            manager.serialize_text(obj, buffer);
+
+            REQUIRE(text() == "{7, {-3, 2.5}}{7, {-3, 2.5}}");
+        }
+
+        SECTION("read back with operator>>")
+        {
+            auto read = tct1_space3::static_construct<tct1_struct2>();
+            std::istringstream in(text());
+            in >> read;
+
+            REQUIRE(tct1_space3::get_held_value<tct1_struct2>(read).index == 7);
+        }
+    }
+
+    SECTION("caller supplied range")
+    {
+        auto obj = tct1_space3::static_construct<tct1_struct>(-3, 2.5);
+        char out[16];
+
+        auto end = manager.serialize_text(obj, out, out + sizeof(out));
+        REQUIRE(std::string(out, end) == "{-3, 2.5}");
+
+        REQUIRE_THROWS_AS(manager.serialize_text(obj, out, out + 5),
+                          shadow::serialization_error);
+
+        // ranges ending inside the text between two member variables
+        REQUIRE_THROWS_AS(manager.serialize_text(obj, out, out + 3),
+                          shadow::serialization_error);
+        REQUIRE_THROWS_AS(manager.serialize_text(obj, out, out + 4),
+                          shadow::serialization_error);
+    }
+
+    SECTION("estimated size ending between two member variables")
+    {
+        // {"x...x" fills the estimated size but for one char, so the ", "
+        // before value is what doesn't fit
+        const auto obj = tct1_space6::static_make_object(
+            tct1_labelled{std::string(92, 'x'), 5});
+        const auto expected = "{\"" + std::string(92, 'x') + "\", 5}";
+
+        tct1_space6::manager.serialize_text(obj, buffer);
+        REQUIRE(text() == expected);
+
+        const shadow::object objects[] = {obj, obj};
+        buffer.clear();
+        tct1_space6::manager.serialize_text(
+            std::begin(objects), std::end(objects), buffer);
+        REQUIRE(text() == expected + "\n" + expected + "\n");
+    }
+}
+
+
+TEST_CASE("parse text from char buffers",
+          "[reflection_manager::deserialize_text]")
+{
+    const auto& manager = tct1_space3::manager;
+
+    auto parse = [&manager](shadow::object& obj, const std::string& text) {
+        return manager.deserialize_text(
+                   obj, text.data(), text.data() + text.size()) -
+               text.data();
+    };
+
+    SECTION("integers")
+    {
+        auto obj = tct1_space3::static_make_object(0);
+
+        REQUIRE(parse(obj, " -42,") == 4);
+        REQUIRE(tct1_space3::get_held_value<int>(obj) == -42);
+
+        parse(obj, std::to_string(std::numeric_limits<int>::min()));
+        REQUIRE(tct1_space3::get_held_value<int>(obj) ==
+                std::numeric_limits<int>::min());
+
+        REQUIRE_THROWS_AS(parse(obj, "2147483648"),
+                          shadow::serialization_error);
+        REQUIRE_THROWS_AS(parse(obj, "x"), shadow::serialization_error);
+    }
+
+    SECTION("floating point values read back what serialize_text wrote")
+    {
+        auto obj = tct1_space3::static_make_object(1.0 / 3.0);
+        std::vector<char> buffer;
+        manager.serialize_text(obj, buffer);
+
+        auto read = tct1_space3::static_make_object(0.0);
+        parse(read, std::string(buffer.begin(), buffer.end()));
+
+        REQUIRE(tct1_space3::get_held_value<double>(read) == 1.0 / 3.0);
+    }
+
+    SECTION("strings, chars and bools")
+    {
+        auto str = tct1_space3::static_make_object(std::string());
+        auto c = tct1_space3::static_make_object('a');
+        auto b = tct1_space3::static_make_object(false);
+
+        parse(str, "\"hello world\"");
+        parse(c, " z");
+        parse(b, "true}");
+
+        REQUIRE(tct1_space3::get_held_value<std::string>(str) ==
+                "hello world");
+        REQUIRE(tct1_space3::get_held_value<char>(c) == 'z');
+        REQUIRE(tct1_space3::get_held_value<bool>(b) == true);
+
+        REQUIRE_THROWS_AS(parse(str, "\"unterminated"),
+                          shadow::serialization_error);
+    }
+
+    SECTION("nested structs")
+    {
+        auto obj = tct1_space3::static_construct<tct1_struct2>();
+
+        const std::string text = "{ 7,{-3 , 2.5} } trailing";
+        REQUIRE(parse(obj, text) ==
+                static_cast<std::ptrdiff_t>(text.find(" trailing")));
+
+        const auto& value = tct1_space3::get_held_value<tct1_struct2>(obj);
+        REQUIRE(value.index == 7);
+        REQUIRE(value.the_struct.i == -3);
+        REQUIRE(value.the_struct.d == 2.5);
+
+        REQUIRE_THROWS_AS(parse(obj, "{7, {-3, 2.5}"),
+                          shadow::serialization_error);
+        REQUIRE_THROWS_AS(parse(obj, "{7 {-3, 2.5}}"),
+                          shadow::serialization_error);
+    }
+}
+
+
+TEST_CASE("serialize ranges of objects of the same type",
+          "[reflection_manager::serialize_text]")
+{
+    const auto& manager = tct1_space3::manager;
+
+    std::vector<shadow::object> objects;
+    for(int i = 0; i < 3; ++i)
+    {
+        objects.push_back(tct1_space3::static_construct<tct1_struct2>(
+            std::size_t(i), tct1_struct{-i, i + 0.5}));
+    }
+
+    SECTION("text, one object per line")
+    {
+        std::vector<char> bulk;
+        manager.serialize_text(objects.begin(), objects.end(), bulk);
+
+        REQUIRE(std::string(bulk.begin(), bulk.end()) ==
+                "{0, {0, 0.5}}\n{1, {-1, 1.5}}\n{2, {-2, 2.5}}\n");
+    }
+
+    SECTION("text of many objects in one buffer")
+    {
+        // the buffer keeps growing with the text of every object, which
+        // mustn't make writing each object cost more than its own text
+        std::vector<shadow::object> many;
+        for(int i = 0; i < 50000; ++i)
+        {
+            many.push_back(tct1_space3::static_construct<tct1_struct2>(
+                std::size_t(i), tct1_struct{i, 0.25}));
+        }
+
+        std::vector<char> bulk = {'#'};
+        manager.serialize_text(many.begin(), many.end(), bulk);
+
+        std::vector<char> single = {'#'};
+        for(const auto& obj : many)
+        {
+            manager.serialize_text(obj, single);
+            single.push_back('\n');
+        }
+
+        REQUIRE(bulk == single);
+        REQUIRE(std::count(bulk.begin(), bulk.end(), '\n') == 50000);
+    }
+
+    SECTION("binary, same as serializing one at a time")
+    {
+        std::vector<char> bulk;
+        manager.serialize_binary(objects.begin(), objects.end(), bulk);
+
+        std::vector<char> single;
+        for(const auto& obj : objects)
+        {
+            manager.serialize_binary(obj, single);
+        }
+
+        REQUIRE(bulk == single);
+    }
+
+    SECTION("objects of different types")
+    {
+        objects.push_back(tct1_space3::static_make_object(1));
+        std::vector<char> buffer;
+
+        REQUIRE_THROWS_AS(
+            manager.serialize_text(objects.begin(), objects.end(), buffer),
+            shadow::type_error);
+
+        // text of the objects before the mismatch is kept
+        REQUIRE(std::string(buffer.begin(), buffer.end()) ==
+                "{0, {0, 0.5}}\n{1, {-1, 1.5}}\n{2, {-2, 2.5}}\n");
+    }
+
+    SECTION("plans built from several threads")
+    {
+        std::vector<std::vector<char>> buffers(4);
+        std::vector<std::thread> threads;
+
+        for(auto& buffer : buffers)
+        {
+            threads.emplace_back([&manager, &objects, &buffer]() {
+                for(int i = 0; i < 50; ++i)
+                {
+                    buffer.clear();
+                    manager.serialize_text(
+                        objects.begin(), objects.end(), buffer);
+                }
+            });
+        }
+
+        for(auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        REQUIRE(std::all_of(
+            buffers.begin(), buffers.end(), [&buffers](const auto& buffer) {
+                return buffer == buffers.front();
+            }));
+    }
+}
+
+
+TEST_CASE("reference member variables in place",
+          "[reflection_manager::member_variable_reference]")
+{
+    const auto& manager = tct1_space::manager;
+    auto s = tct1_space::static_construct<tct1_struct>(20, 44.2);
+
+    const auto i_mv =
+        *manager.find_member_variable(s.type(), shadow::string_view("i"));
+    const auto d_mv =
+        *manager.find_member_variable(s.type(), shadow::string_view("d"));
+
+    SECTION("read and write through a reference")
+    {
+        auto i_ref = manager.member_variable_reference(s, i_mv);
+        auto d_ref = manager.member_variable_reference(s, d_mv);
+
+        REQUIRE(i_ref.type().name() == std::string("int"));
+        REQUIRE(d_ref.type().name() == std::string("double"));
+        REQUIRE(i_ref.get<int>() == 20);
+        REQUIRE(d_ref.get<double>() == Approx(44.2));
+
+        i_ref.get<int>() = 30;
+        REQUIRE(tct1_space::get_held_value<tct1_struct>(s).i == 30);
+
+        REQUIRE(i_ref.address() ==
+                &tct1_space::get_held_value<tct1_struct>(s).i);
+    }
+
+    SECTION("references from const objects")
+    {
+        const shadow::object& cs = s;
+        shadow::const_member_reference ref =
+            manager.member_variable_reference(cs, d_mv);
+
+        REQUIRE(ref.get<double>() == Approx(44.2));
+
+        shadow::const_member_reference converted =
+            manager.member_variable_reference(s, i_mv);
+
+        REQUIRE(converted.get<int>() == 20);
+    }
+
+    SECTION("set through a reference")
+    {
+        auto i_ref = manager.member_variable_reference(s, i_mv);
+
+        manager.set_member_reference(i_ref,
+                                     tct1_space::static_construct<int>(40));
+
+        REQUIRE(tct1_space::get_held_value<tct1_struct>(s).i == 40);
+        REQUIRE(tct1_space::get_held_value<tct1_struct>(s).d == Approx(44.2));
+
+        REQUIRE_THROWS_AS(
+            manager.set_member_reference(
+                i_ref, tct1_space::static_construct<double>(1.0)),
+            shadow::type_error);
+    }
+
+    SECTION("set a reference made by another manager")
+    {
+        auto i_ref = manager.member_variable_reference(s, i_mv);
+
+        tct1_space3::manager.set_member_reference(
+            i_ref, tct1_space3::static_make_object(50));
+
+        REQUIRE(tct1_space::get_held_value<tct1_struct>(s).i == 50);
+
+        REQUIRE_THROWS_AS(tct1_space3::manager.set_member_reference(
+                              i_ref, tct1_space3::static_make_object(1.0)),
+                          shadow::type_error);
+    }
+
+    SECTION("reference member variable of wrong class")
+    {
+        auto c = tct1_space::static_construct<tct1_class>();
+
+        REQUIRE_THROWS_AS(manager.member_variable_reference(c, i_mv),
+                          shadow::type_error);
+    }
+}
+
+
+TEST_CASE("access member variables by offset",
+          "[reflection_manager::member_variable_accessor]")
+{
+    const auto& manager = tct1_space::manager;
+    auto s = tct1_space::static_construct<tct1_struct>(20, 44.2);
+
+    const auto i_mv =
+        *manager.find_member_variable(s.type(), shadow::string_view("i"));
+    const auto d_mv =
+        *manager.find_member_variable(s.type(), shadow::string_view("d"));
+
+    SECTION("read and write through accessors")
+    {
+        const auto i_access = manager.member_variable_accessor<int>(i_mv);
+        const auto d_access = manager.member_variable_accessor<double>(d_mv);
+
+        REQUIRE(i_access.offset() == offsetof(tct1_struct, i));
+        REQUIRE(d_access.offset() == offsetof(tct1_struct, d));
+
+        const shadow::object& cs = s;
+        REQUIRE(i_access.get(cs) == 20);
+        REQUIRE(d_access.get(cs) == Approx(44.2));
+
+        i_access.set(s, 30);
+        d_access.get(s) = 1.5;
+
+        REQUIRE(tct1_space::get_held_value<tct1_struct>(s).i == 30);
+        REQUIRE(tct1_space::get_held_value<tct1_struct>(s).d == Approx(1.5));
+    }
+
+    SECTION("the same accessor for many objects")
+    {
+        const auto i_access = manager.member_variable_accessor<int>(i_mv);
+
+        std::vector<shadow::object> objects;
+        for(int i = 0; i < 10; ++i)
+        {
+            objects.push_back(
+                tct1_space::static_construct<tct1_struct>(i, 0.0));
+        }
+
+        int sum = 0;
+        for(const auto& obj : objects)
+        {
+            sum += i_access.get(obj);
+        }
+
+        REQUIRE(sum == 45);
+    }
+
+    SECTION("accessor of mismatching type")
+    {
+        // same size as the member variable, but a different type
+        REQUIRE_THROWS_AS(manager.member_variable_accessor<float>(i_mv),
+                          shadow::type_error);
+        REQUIRE_THROWS_AS(manager.member_variable_accessor<long>(d_mv),
+                          shadow::type_error);
+        REQUIRE_THROWS_AS(manager.member_variable_accessor<double>(i_mv),
+                          shadow::type_error);
+        REQUIRE_THROWS_AS(manager.member_variable_accessor<std::string>(d_mv),
+                          shadow::type_error);
+    }
+}
+
+
+TEST_CASE("invoke free functions with typed arguments",
+          "[reflection_manager::invoke]")
+{
+    const auto& manager = tct1_space5::manager;
+
+    const auto find = [&manager](const char* name) {
+        return *manager.find_free_function(name);
+    };
+
+    SECTION("values, references and pointers")
+    {
+        REQUIRE(manager.invoke<int>(find("make_number")) == 4248);
+        REQUIRE(manager.invoke<int>(
+                    find("sum_many"), 1, 2, 3, 4, 5, 6, 7, 8, 9, 10) == 55);
+
+        const std::string str("ab");
+        REQUIRE(manager.invoke<std::string>(find("repeat"), str, 3) ==
+                "ababab");
+        REQUIRE(manager.invoke<std::string>(
+                    find("repeat"), std::string("c"), 2) == "cc");
+
+        int i = 4;
+        manager.invoke<void>(find("triple"), i);
+        REQUIRE(i == 12);
+
+        manager.invoke<void>(find("modify"), &i);
+        REQUIRE(i == 22);
+
+        REQUIRE(manager.invoke<std::size_t>(find("length_of"), "four") == 4);
+    }
+
+    SECTION("signature mismatches")
+    {
+        REQUIRE_THROWS_AS(manager.invoke<int>(find("sum_many"), 1, 2),
+                          shadow::argument_error);
+        REQUIRE_THROWS_AS(manager.invoke<std::string>(find("repeat"), 1, 3),
+                          shadow::argument_error);
+        REQUIRE_THROWS_AS(
+            manager.invoke<std::string>(find("repeat"), std::string("a"), 1.0),
+            shadow::argument_error);
+
+        int i = 0;
+        REQUIRE_THROWS_AS(manager.invoke<void>(find("modify"), i),
+                          shadow::argument_error);
+        REQUIRE_THROWS_AS(manager.invoke<double>(find("make_number")),
+                          shadow::type_error);
+        REQUIRE_THROWS_AS(manager.invoke<int>(find("triple"), i),
+                          shadow::type_error);
+        // no operations for non-copyable types, which still aren't void
+        REQUIRE_THROWS_AS(
+            manager.invoke<std::unique_ptr<int>>(find("triple"), i),
+            shadow::type_error);
+    }
+
+    SECTION("const and temporary arguments to writable parameters")
+    {
+        const int ci = 2;
+        REQUIRE_THROWS_AS(manager.invoke<void>(find("triple"), ci),
+                          shadow::argument_error);
+        REQUIRE_THROWS_AS(manager.invoke<void>(find("triple"), 2),
+                          shadow::argument_error);
+        REQUIRE_THROWS_AS(manager.invoke<void>(find("modify"), &ci),
+                          shadow::argument_error);
+        REQUIRE(ci == 2);
+
+        REQUIRE_THROWS_AS(
+            manager.free_function_handle<void(int)>(find("triple")),
+            shadow::argument_error);
+        REQUIRE_THROWS_AS(
+            manager.free_function_handle<void(const int&)>(find("triple")),
+            shadow::argument_error);
+        REQUIRE_THROWS_AS(
+            manager.free_function_handle<void(const int*)>(find("modify")),
+            shadow::argument_error);
+
+        // parameters that don't write through their arguments take anything
+        REQUIRE(manager.invoke<std::string>(
+                    find("repeat"), std::string("c"), ci) == "cc");
+    }
+
+    SECTION("handles checked once")
+    {
+        const auto repeat_handle =
+            manager.free_function_handle<std::string(std::string, int)>(
+                find("repeat"));
+
+        REQUIRE(repeat_handle("x", 2) == "xx");
+        REQUIRE(repeat_handle(std::string("yz"), 1) == "yz");
+
+        const auto triple_handle =
+            manager.free_function_handle<void(int&)>(find("triple"));
+
+        int i = 1;
+        for(int n = 0; n < 3; ++n)
+        {
+            triple_handle(i);
+        }
+        REQUIRE(i == 27);
+
+        REQUIRE_THROWS_AS(
+            manager.free_function_handle<int(int)>(find("make_number")),
+            shadow::argument_error);
+        REQUIRE_THROWS_AS(
+            manager.free_function_handle<double(std::string, int)>(
+                find("repeat")),
+            shadow::type_error);
+    }
+}
+
+
+TEST_CASE("bound calls checked once and called repeatedly",
+          "[reflection_manager::bind_call]")
+{
+    const auto& manager = tct1_space2::manager;
+
+    const auto find_ff = [&manager](const char* name) {
+        return *manager.find_free_function(name);
+    };
+
+    const auto class_type = tct1_space2::static_construct<tct1_class>(0).type();
+    const auto find_mf = [&manager, &class_type](const char* name) {
+        return *manager.find_member_function(class_type, name);
+    };
+
+    std::vector<shadow::object> int_arg = {
+        tct1_space2::static_make_object(3)};
+
+    SECTION("free function with pointer parameter")
+    {
+        auto call = manager.bind_call(
+            find_ff("mult"), int_arg.begin(), int_arg.end());
+
+        REQUIRE(call.size() == 1);
+        REQUIRE(tct1_space2::get_held_value<int>(call.call()) == 6);
+
+        for(int i = 0; i < 10; ++i)
+        {
+            call.get<int>(0) = i;
+            REQUIRE(tct1_space2::get_held_value<int>(call.call()) == 2 * i);
+        }
+
+        call.set_argument(0, tct1_space2::static_make_object(21));
+        REQUIRE(tct1_space2::get_held_value<int>(call.call()) == 42);
+    }
+
+    SECTION("out parameters stay in the slots")
+    {
+        auto call = manager.bind_call(
+            find_ff("modify"), int_arg.begin(), int_arg.end());
+        call.call();
+        call.call();
+
+        REQUIRE(tct1_space2::get_held_value<int>(call.argument(0)) == 23);
+
+        auto triple_call = manager.bind_call(
+            find_ff("triple"), int_arg.begin(), int_arg.end());
+        triple_call.call();
+        triple_call.call();
+
+        REQUIRE(triple_call.get<int>(0) == 27);
+        REQUIRE(tct1_space2::get_held_value<int>(int_arg[0]) == 3);
+    }
+
+    SECTION("arguments kept past the bound_call")
+    {
+        std::vector<shadow::object> kept;
+        {
+            auto call = manager.bind_call(
+                find_ff("modify"), int_arg.begin(), int_arg.end());
+            call.call();
+
+            kept.push_back(call.argument(0));
+            shadow::object copy = call.argument(0);
+            kept.push_back(copy);
+        }
+
+        REQUIRE(tct1_space2::get_held_value<int>(kept[0]) == 13);
+        REQUIRE(tct1_space2::get_held_value<int>(kept[1]) == 13);
+    }
+
+    SECTION("copies have their own slots")
+    {
+        auto call = manager.bind_call(
+            find_ff("modify"), int_arg.begin(), int_arg.end());
+        auto copy = call;
+
+        copy.call();
+
+        REQUIRE(call.get<int>(0) == 3);
+        REQUIRE(copy.get<int>(0) == 13);
+
+        auto moved = std::move(copy);
+        moved.call();
+        REQUIRE(moved.get<int>(0) == 23);
+    }
+
+    SECTION("member functions")
+    {
+        auto obj = tct1_space2::static_construct<tct1_class>(7);
+
+        auto set_call = manager.bind_call(
+            find_mf("set_i"), int_arg.begin(), int_arg.end());
+        set_call.call(obj);
+        REQUIRE(tct1_space2::get_held_value<tct1_class>(obj).get_i() == 3);
+
+        std::vector<shadow::object> no_args;
+        auto get_call =
+            manager.bind_call(find_mf("get_i"), no_args.begin(), no_args.end());
+
+        std::vector<shadow::object> objects;
+        for(int i = 0; i < 5; ++i)
+        {
+            objects.push_back(tct1_space2::static_construct<tct1_class>(i));
+        }
+
+        int sum = 0;
+        for(auto& o : objects)
+        {
+            sum += tct1_space2::get_held_value<int>(get_call.call(o));
+        }
+        REQUIRE(sum == 10);
+
+        auto out_call = manager.bind_call(
+            find_mf("pointer_out"), int_arg.begin(), int_arg.end());
+        out_call.call(obj);
+        REQUIRE(out_call.get<int>(0) == 3);
+
+        REQUIRE_THROWS_AS(get_call.call(), shadow::argument_error);
+        REQUIRE_THROWS_AS(get_call.call(int_arg[0]), shadow::type_error);
+    }
+
+    SECTION("mismatching arguments")
+    {
+        std::vector<shadow::object> wrong = {
+            tct1_space2::static_construct<tct1_class>(1)};
+
+        REQUIRE_THROWS_AS(
+            manager.bind_call(find_ff("mult"), wrong.begin(), wrong.end()),
+            shadow::argument_error);
+
+        auto call = manager.bind_call(
+            find_ff("mult"), int_arg.begin(), int_arg.end());
+
+        REQUIRE_THROWS_AS(call.set_argument(0, wrong[0]),
+                          shadow::argument_error);
+        REQUIRE_THROWS_AS(call.argument(1), shadow::argument_error);
+        REQUIRE_THROWS_AS(call.call(wrong[0]), shadow::argument_error);
+    }
+}
+
+
+TEST_CASE("call free functions over columns of arguments",
+          "[reflection_manager::invoke_batch]")
+{
+    const auto& manager = tct1_space5::manager;
+
+    const auto find = [&manager](const char* name) {
+        return *manager.find_free_function(name);
+    };
+
+    SECTION("typed columns")
+    {
+        const std::vector<std::string> strings = {"a", "bc", "def"};
+        const std::vector<int> times = {3, 2, 1};
+        std::vector<std::string> repeated(3);
+
+        manager.invoke_batch(
+            find("repeat"), 3, repeated.data(), strings.data(), times.data());
+
+        REQUIRE(repeated == std::vector<std::string>({"aaa", "bcbc", "def"}));
+
+        std::vector<int> ints = {1, 2, 3, 4};
+        manager.invoke_batch<void>(find("triple"), 4, nullptr, ints.data());
+        manager.invoke_batch<void>(find("modify"), 4, nullptr, ints.data());
+
+        REQUIRE(ints == std::vector<int>({13, 16, 19, 22}));
+
+        int number = 0;
+        manager.invoke_batch(find("make_number"), 1, &number);
+        REQUIRE(number == 4248);
+    }
+
+    SECTION("mismatching typed columns")
+    {
+        std::vector<double> doubles = {1.0};
+        std::vector<int> ints = {1};
+        std::vector<std::string> results(1);
+        int result = 0;
+
+        REQUIRE_THROWS_AS(manager.invoke_batch<void>(
+                              find("triple"), 1, nullptr, doubles.data()),
+                          shadow::argument_error);
+        REQUIRE_THROWS_AS(manager.invoke_batch(
+                              find("repeat"), 1, results.data(), ints.data()),
+                          shadow::argument_error);
+        REQUIRE_THROWS_AS(
+            manager.invoke_batch(find("repeat"),
+                                 1,
+                                 &result,
+                                 results.data(),
+                                 ints.data()),
+            shadow::type_error);
+        REQUIRE_THROWS_AS(manager.invoke_batch<std::unique_ptr<int>>(
+                              find("triple"), 1, nullptr, ints.data()),
+                          shadow::type_error);
+    }
+
+    SECTION("const columns for writable parameters")
+    {
+        const std::vector<int> ints = {1, 2};
+
+        REQUIRE_THROWS_AS(manager.invoke_batch<void>(
+                              find("triple"), 2, nullptr, ints.data()),
+                          shadow::argument_error);
+        REQUIRE_THROWS_AS(manager.invoke_batch<void>(
+                              find("modify"), 2, nullptr, ints.data()),
+                          shadow::argument_error);
+        // the registered kernel takes int*
+        REQUIRE_THROWS_AS(manager.invoke_batch<void>(
+                              find("twice"), 2, nullptr, ints.data()),
+                          shadow::argument_error);
+
+        REQUIRE(ints == std::vector<int>({1, 2}));
+    }
+
+    SECTION("object_vector columns")
+    {
+        const auto int_type = tct1_space5::static_make_object(0).type();
+        const auto string_type =
+            tct1_space5::static_make_object(std::string()).type();
+
+        shadow::object_vector strings(manager, string_type);
+        shadow::object_vector times(manager, int_type);
+        shadow::object_vector repeated(manager, string_type);
+
+        for(int i = 0; i < 4; ++i)
+        {
+            strings.push_back(
+                tct1_space5::static_make_object(std::string("x")));
+            times.push_back(tct1_space5::static_make_object(i));
+        }
+        repeated.resize(4, tct1_space5::static_make_object(std::string()));
+
+        shadow::object_vector* columns[] = {&strings, &times};
+        manager.call_free_function_batch(
+            find("repeat"), std::begin(columns), std::end(columns), repeated);
+
+        REQUIRE(tct1_space5::get_held_value<std::string>(repeated[0]) == "");
+        REQUIRE(tct1_space5::get_held_value<std::string>(repeated[3]) ==
+                "xxx");
+
+        shadow::object_vector* int_column[] = {&times};
+        manager.call_free_function_batch(
+            find("triple"), std::begin(int_column), std::end(int_column));
+
+        REQUIRE(tct1_space5::get_held_value<int>(times[3]) == 9);
+
+        SECTION("mismatching columns")
+        {
+            shadow::object_vector* swapped[] = {&times, &strings};
+            REQUIRE_THROWS_AS(
+                manager.call_free_function_batch(find("repeat"),
+                                                 std::begin(swapped),
+                                                 std::end(swapped),
+                                                 repeated),
+                shadow::argument_error);
+
+            times.pop_back();
+            REQUIRE_THROWS_AS(
+                manager.call_free_function_batch(find("repeat"),
+                                                 std::begin(columns),
+                                                 std::end(columns),
+                                                 repeated),
+                shadow::argument_error);
+
+            REQUIRE_THROWS_AS(
+                manager.call_free_function_batch(find("repeat"),
+                                                 std::begin(columns),
+                                                 std::end(columns),
+                                                 times),
+                shadow::type_error);
+
+            REQUIRE_THROWS_AS(
+                manager.call_free_function_batch(
+                    find("repeat"), std::begin(columns), std::end(columns)),
+                shadow::type_error);
+        }
+    }
+}
+
+
+TEST_CASE("call member functions on every value of an object_vector",
+          "[reflection_manager::call_member_function_batch]")
+{
+    const auto& manager = tct1_space2::manager;
+
+    const auto class_type = tct1_space2::static_construct<tct1_class>(0).type();
+    const auto find = [&manager, &class_type](const char* name) {
+        return *manager.find_member_function(class_type, name);
+    };
+
+    shadow::object_vector objects(manager, class_type);
+    for(int i = 0; i < 5; ++i)
+    {
+        objects.push_back(tct1_space2::static_construct<tct1_class>(i));
+    }
+
+    std::vector<shadow::object> no_args;
+    std::vector<shadow::object> int_arg = {
+        tct1_space2::static_make_object(7)};
+
+    SECTION("return values are assigned to results")
+    {
+        const auto int_type = tct1_space2::static_make_object(0).type();
+        shadow::object_vector results(manager, int_type);
+        results.resize(5, tct1_space2::static_make_object(0));
+
+        manager.call_member_function_batch(
+            objects, find("get_i"), no_args.begin(), no_args.end(), results);
+
+        for(int i = 0; i < 5; ++i)
+        {
+            REQUIRE(tct1_space2::get_held_value<int>(results[i]) == i);
+        }
+
+        SECTION("mismatching results")
+        {
+            results.pop_back();
+            REQUIRE_THROWS_AS(
+                manager.call_member_function_batch(objects,
+                                                   find("get_i"),
+                                                   no_args.begin(),
+                                                   no_args.end(),
+                                                   results),
+                shadow::argument_error);
+
+            shadow::object_vector wrong(manager, class_type);
+            REQUIRE_THROWS_AS(
+                manager.call_member_function_batch(objects,
+                                                   find("get_i"),
+                                                   no_args.begin(),
+                                                   no_args.end(),
+                                                   wrong),
+                shadow::type_error);
+        }
+    }
+
+    SECTION("the same arguments are passed to every call")
+    {
+        manager.call_member_function_batch(
+            objects, find("set_i"), int_arg.begin(), int_arg.end());
+
+        for(const auto& obj : objects)
+        {
+            REQUIRE(tct1_space2::get_held_value<tct1_class>(obj).get_i() == 7);
+        }
+
+        manager.call_member_function_batch(
+            objects, find("get_i"), no_args.begin(), no_args.end());
+    }
+
+    SECTION("out parameters are passed back after the last call")
+    {
+        manager.call_member_function_batch(
+            objects, find("pointer_out"), int_arg.begin(), int_arg.end());
+
+        REQUIRE(tct1_space2::get_held_value<int>(int_arg[0]) == 4);
+    }
+
+    SECTION("mismatching objects and arguments")
+    {
+        REQUIRE_THROWS_AS(
+            manager.call_member_function_batch(
+                objects, find("set_i"), no_args.begin(), no_args.end()),
+            shadow::argument_error);
+
+        shadow::object_vector ints(manager,
+                                   tct1_space2::static_make_object(0).type());
+        REQUIRE_THROWS_AS(
+            manager.call_member_function_batch(
+                ints, find("get_i"), no_args.begin(), no_args.end()),
+            shadow::type_error);
+    }
+}
+
+
+TEST_CASE("batch calls use registered batch kernels",
+          "[reflection_manager::free_function_has_batch_kernel]")
+{
+    const auto& manager = tct1_space5::manager;
+
+    const auto find = [&manager](const char* name) {
+        return *manager.find_free_function(name);
+    };
+
+    REQUIRE(manager.free_function_has_batch_kernel(find("add_ints")));
+    REQUIRE(manager.free_function_has_batch_kernel(find("twice")));
+    REQUIRE_FALSE(manager.free_function_has_batch_kernel(find("triple")));
+
+    batch_kernel_calls = 0;
+
+    const std::vector<int> a = {1, 2, 3};
+    const std::vector<int> b = {10, 20, 30};
+    std::vector<int> sums(3);
+
+    manager.invoke_batch(find("add_ints"), 3, sums.data(), a.data(), b.data());
+
+    REQUIRE(sums == std::vector<int>({11, 22, 33}));
+    REQUIRE(batch_kernel_calls == 1);
+
+    const auto int_type = tct1_space5::static_make_object(0).type();
+    shadow::object_vector values(manager, int_type);
+    values.resize(4, tct1_space5::static_make_object(5));
+
+    shadow::object_vector* columns[] = {&values};
+    manager.call_free_function_batch(
+        find("twice"), std::begin(columns), std::end(columns));
+
+    REQUIRE(tct1_space5::get_held_value<int>(values[3]) == 10);
+    REQUIRE(batch_kernel_calls == 2);
+
+    // single calls still go through the function itself
+    REQUIRE(manager.invoke<int>(find("add_ints"), 4, 5) == 9);
+    REQUIRE(batch_kernel_calls == 2);
+
+    SECTION("overloaded function and kernel")
+    {
+        REQUIRE(manager.free_function_has_batch_kernel(find("halve")));
+
+        std::vector<double> doubles = {1.0, 3.0};
+        manager.invoke_batch<void>(find("halve"), 2, nullptr, doubles.data());
+
+        REQUIRE(doubles == std::vector<double>({0.5, 1.5}));
+        REQUIRE(batch_kernel_calls == 3);
+
+        std::vector<int> ints = {2};
+        REQUIRE_THROWS_AS(
+            manager.invoke_batch<void>(find("halve"), 1, nullptr, ints.data()),
+            shadow::argument_error);
+    }
+}
@@ -0,0 +1,341 @@
+#include "catch.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <shadow.hpp>
+#include <object_vector.hpp>
+
+
+struct tov_point
+{
+    double x;
+    double y;
+
+    double
+    length_squared() const
+    {
+        return x * x + y * y;
+    }
+};
+
+struct tov_named
+{
+    int id;
+    std::string name;
+
+    std::string
+    greeting() const
+    {
+        return "hello " + name;
+    }
+};
+
+// copies and moves throw once tov_fragile_operations_left runs out, unless it
+// is negative
+int tov_fragile_operations_left = -1;
+
+struct tov_fragile
+{
+    tov_fragile() : value(0)
+    {
+    }
+
+    explicit tov_fragile(int v) : value(v)
+    {
+    }
+
+    tov_fragile(const tov_fragile& other) : value(other.value)
+    {
+        count_operation();
+    }
+
+    tov_fragile(tov_fragile&& other) : value(other.value)
+    {
+        count_operation();
+    }
+
+    tov_fragile& operator=(const tov_fragile&) = default;
+    tov_fragile& operator=(tov_fragile&&) = default;
+
+    static void
+    count_operation()
+    {
+        if(tov_fragile_operations_left == 0)
+        {
+            throw std::runtime_error("tov_fragile operation failed");
+        }
+
+        if(tov_fragile_operations_left > 0)
+        {
+            --tov_fragile_operations_left;
+        }
+    }
+
+    int value;
+};
+
+namespace tov_space
+{
+REGISTER_TYPE_BEGIN()
+REGISTER_TYPE(tov_point)
+REGISTER_TYPE(tov_named)
+REGISTER_TYPE(tov_fragile)
+REGISTER_TYPE_END()
+
+REGISTER_MEMBER_VARIABLE(tov_point, x)
+REGISTER_MEMBER_VARIABLE(tov_point, y)
+REGISTER_MEMBER_VARIABLE(tov_named, id)
+REGISTER_MEMBER_VARIABLE(tov_named, name)
+
+REGISTER_MEMBER_FUNCTION(tov_point, length_squared)
+REGISTER_MEMBER_FUNCTION(tov_named, greeting)
+
+SHADOW_INIT()
+} // namespace tov_space
+
+
+namespace
+{
+shadow::type_tag
+named_type()
+{
+    return tov_space::static_make_object(tov_named{}).type();
+}
+
+shadow::member_variable_tag
+named_field(const char* name)
+{
+    return *tov_space::manager.find_member_variable(named_type(), name);
+}
+
+shadow::object
+make_named(int id, const char* name)
+{
+    return tov_space::static_make_object(tov_named{id, name});
+}
+} // namespace
+
+
+TEST_CASE("store values contiguously in an object_vector", "[object_vector]")
+{
+    const auto& manager = tov_space::manager;
+
+    shadow::object_vector names(manager, named_type());
+
+    REQUIRE(names.empty());
+    REQUIRE(names.type() == named_type());
+
+    for(int i = 0; i < 20; ++i)
+    {
+        names.push_back(make_named(i, std::to_string(i).c_str()));
+    }
+
+    REQUIRE(names.size() == 20);
+    REQUIRE(names.capacity() >= 20);
+
+    SECTION("values are laid out back to back")
+    {
+        const auto first = static_cast<const tov_named*>(names.data());
+
+        REQUIRE(first[0].name == "0");
+        REQUIRE(first[19].name == "19");
+        REQUIRE(names[7].type() == named_type());
+        REQUIRE(manager.get<tov_named>(names[7]).id == 7);
+    }
+
+    SECTION("elements refer to the values in place")
+    {
+        auto element = names[3];
+
+        manager.set_member_variable(
+            element,
+            named_field("name"),
+            tov_space::static_make_object(std::string("three")));
+
+        REQUIRE(static_cast<const tov_named*>(names.data())[3].name ==
+                "three");
+
+        auto id = manager.get_member_variable(names[3], named_field("id"));
+        REQUIRE(manager.get<int>(id) == 3);
+    }
+
+    SECTION("call member functions through elements")
+    {
+        const auto mfs = manager.member_functions_by_class_type(named_type());
+        REQUIRE(mfs.first != mfs.second);
+
+        auto element = names[5];
+        auto result = manager.call_member_function(element, *mfs.first);
+
+        REQUIRE(manager.get<std::string>(result) == "hello 5");
+    }
+
+    SECTION("copies of elements hold their own values")
+    {
+        const auto element = names[1];
+        shadow::object copy = element;
+        manager.get<tov_named>(copy).name = "copy";
+
+        REQUIRE(manager.get<tov_named>(names[1]).name == "1");
+    }
+
+    SECTION("objects initialized from elements hold their own values")
+    {
+        shadow::object copy = names[2];
+        manager.get<tov_named>(copy).name = "copy";
+
+        const auto& const_names = names;
+        for(shadow::object element : const_names)
+        {
+            manager.get<tov_named>(element).name = "copy";
+        }
+
+        REQUIRE(manager.get<tov_named>(names[2]).name == "2");
+        REQUIRE(manager.get<tov_named>(names[19]).name == "19");
+
+        using const_reference = shadow::object_vector::const_reference;
+        REQUIRE_FALSE(
+            (std::is_convertible<const_reference, shadow::object&>::value));
+    }
+
+    SECTION("elements stored in other containers outlive reallocation")
+    {
+        std::vector<shadow::object> objects;
+        for(std::size_t i = 0; i < names.size(); ++i)
+        {
+            objects.push_back(names[i]);
+        }
+
+        names.reserve(names.capacity() * 2);
+        names.clear();
+
+        REQUIRE(manager.get<tov_named>(objects[4]).name == "4");
+    }
+
+    SECTION("copies of references refer to the same value")
+    {
+        auto element = names[6];
+        auto same = element;
+        manager.get<tov_named>(same).id = 60;
+
+        REQUIRE(manager.get<tov_named>(names[6]).id == 60);
+    }
+
+    SECTION("iterate")
+    {
+        int sum = 0;
+        for(const auto& element : names)
+        {
+            sum += manager.get<tov_named>(element).id;
+        }
+
+        REQUIRE(sum == 190);
+    }
+
+    SECTION("push back an element of the same vector")
+    {
+        names.reserve(names.size());
+        names.push_back(names[0]);
+
+        REQUIRE(names.size() == 21);
+        REQUIRE(manager.get<tov_named>(names[20]).name == "0");
+    }
+
+    SECTION("copy, move and pop")
+    {
+        auto copy = names;
+        names.pop_back();
+
+        REQUIRE(copy.size() == 20);
+        REQUIRE(names.size() == 19);
+        REQUIRE(manager.get<tov_named>(copy[19]).name == "19");
+
+        auto moved = std::move(copy);
+        REQUIRE(moved.size() == 20);
+        REQUIRE(copy.empty());
+
+        names = moved;
+        REQUIRE(names.size() == 20);
+        REQUIRE(manager.get<tov_named>(names[10]).name == "10");
+
+        names.clear();
+        REQUIRE(names.empty());
+    }
+
+    SECTION("errors")
+    {
+        REQUIRE_THROWS_AS(names.at(20), shadow::argument_error);
+        REQUIRE_THROWS_AS(
+            names.push_back(tov_space::static_make_object(tov_point{1.0, 2.0})),
+            shadow::type_error);
+    }
+}
+
+
+TEST_CASE("object_vector of trivially copyable values", "[object_vector]")
+{
+    const auto& manager = tov_space::manager;
+    const auto point_type =
+        tov_space::static_make_object(tov_point{0.0, 0.0}).type();
+
+    shadow::object_vector points(manager, point_type);
+    for(int i = 0; i < 100; ++i)
+    {
+        points.push_back(
+            tov_space::static_make_object(tov_point{1.0 * i, 1.0}));
+    }
+
+    const auto mfs = manager.member_functions_by_class_type(point_type);
+
+    double sum = 0.0;
+    for(auto element : points)
+    {
+        sum += manager.get<double>(
+            manager.call_member_function(element, *mfs.first));
+    }
+
+    REQUIRE(sum == Approx(328350.0 + 100.0));
+}
+
+
+TEST_CASE("object_vector keeps its values if relocating them throws",
+          "[object_vector]")
+{
+    const auto& manager = tov_space::manager;
+    const auto fragile_type =
+        tov_space::static_make_object(tov_fragile(0)).type();
+
+    shadow::object_vector values(manager, fragile_type);
+    for(int i = 0; i < 4; ++i)
+    {
+        values.push_back(tov_space::static_make_object(tov_fragile(i)));
+    }
+    REQUIRE(values.capacity() == 4);
+
+    SECTION("reserve")
+    {
+        tov_fragile_operations_left = 2;
+        REQUIRE_THROWS_AS(values.reserve(16), std::runtime_error);
+        tov_fragile_operations_left = -1;
+    }
+
+    SECTION("push_back")
+    {
+        const auto value = tov_space::static_make_object(tov_fragile(4));
+
+        tov_fragile_operations_left = 3;
+        REQUIRE_THROWS_AS(values.push_back(value), std::runtime_error);
+        tov_fragile_operations_left = -1;
+    }
+
+    REQUIRE(values.size() == 4);
+    REQUIRE(values.capacity() == 4);
+
+    for(int i = 0; i < 4; ++i)
+    {
+        REQUIRE(manager.get<tov_fragile>(values[i]).value == i);
+    }
+}
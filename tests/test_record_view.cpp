@@ -0,0 +1,226 @@
+#include "catch.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <shadow.hpp>
+#include <mapped_file.hpp>
+#include <record_view.hpp>
+
+
+struct trv_point
+{
+    int x;
+    double y;
+};
+
+struct trv_named
+{
+    int id;
+    std::string name;
+};
+
+
+namespace trv_space
+{
+REGISTER_TYPE_BEGIN()
+REGISTER_TYPE(trv_point)
+REGISTER_TYPE(trv_named)
+REGISTER_TYPE_END()
+
+REGISTER_MEMBER_VARIABLE(trv_point, x)
+REGISTER_MEMBER_VARIABLE(trv_point, y)
+REGISTER_MEMBER_VARIABLE(trv_named, id)
+REGISTER_MEMBER_VARIABLE(trv_named, name)
+
+SHADOW_INIT()
+} // namespace trv_space
+
+
+namespace
+{
+shadow::type_tag
+point_type()
+{
+    return trv_space::static_construct<trv_point>().type();
+}
+
+shadow::member_variable_tag
+point_field(const char* name)
+{
+    return *trv_space::manager.find_member_variable(point_type(), name);
+}
+} // namespace
+
+
+TEST_CASE("view packed records in memory", "[record_view]")
+{
+    const std::vector<trv_point> points = {{1, 1.5}, {2, 2.5}, {3, 3.5}};
+
+    shadow::record_view view(trv_space::manager,
+                             point_type(),
+                             points.data(),
+                             points.size() * sizeof(trv_point));
+
+    REQUIRE(view.size() == 3);
+    REQUIRE(view.type() == point_type());
+
+    SECTION("read fields in place")
+    {
+        const auto x = point_field("x");
+        const auto y = point_field("y");
+
+        REQUIRE(view.get<int>(1, x) == 2);
+        REQUIRE(view.get<double>(2, y) == 3.5);
+        REQUIRE(view.field(0, y) == &points[0].y);
+        REQUIRE(view.record(2) == &points[2]);
+    }
+
+    SECTION("read fields through typed handles")
+    {
+        const auto x = view.typed_field<int>(point_field("x"));
+        const auto y = view.typed_field<double>(point_field("y"));
+
+        int sum = 0;
+        for(std::size_t i = 0; i < view.size(); ++i)
+        {
+            sum += view.get(i, x);
+        }
+
+        REQUIRE(sum == 6);
+        REQUIRE(view.get(1, y) == 2.5);
+        REQUIRE_THROWS_AS(view.get(3, x), shadow::argument_error);
+    }
+
+    SECTION("wrong accesses")
+    {
+        REQUIRE_THROWS_AS(view.record(3), shadow::argument_error);
+        REQUIRE_THROWS_AS(view.get<double>(0, point_field("x")),
+                          shadow::type_error);
+
+        // same size as the int field, but a different type
+        REQUIRE_THROWS_AS(view.get<float>(0, point_field("x")),
+                          shadow::type_error);
+        REQUIRE_THROWS_AS(view.typed_field<float>(point_field("x")),
+                          shadow::type_error);
+
+        auto named = trv_space::static_construct<trv_named>().type();
+        auto id = *trv_space::manager.find_member_variable(named, "id");
+        REQUIRE_THROWS_AS(view.get<int>(0, id), shadow::type_error);
+    }
+}
+
+
+TEST_CASE("reject data that doesn't fit the record type", "[record_view]")
+{
+    const trv_point points[2] = {{1, 1.5}, {2, 2.5}};
+
+    REQUIRE_THROWS_AS(shadow::record_view(trv_space::manager,
+                                          point_type(),
+                                          points,
+                                          sizeof(points) - 1),
+                      shadow::serialization_error);
+
+    auto named = trv_space::static_construct<trv_named>().type();
+    REQUIRE_THROWS_AS(
+        shadow::record_view(trv_space::manager, named, nullptr, 0),
+        shadow::type_error);
+}
+
+
+TEST_CASE("view records of a mapped file", "[mapped_file]")
+{
+    const std::string path = "test_record_view.bin";
+    const trv_point points[2] = {{10, -1.0}, {20, -2.0}};
+
+    {
+        std::ofstream out(path, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(points), sizeof(points));
+    }
+
+    {
+        shadow::mapped_file file(path);
+        REQUIRE(file.size() == sizeof(points));
+
+        shadow::mapped_file moved(std::move(file));
+        REQUIRE(file.data() == nullptr);
+
+        shadow::record_view view(
+            trv_space::manager, point_type(), moved.data(), moved.size());
+
+        REQUIRE(view.size() == 2);
+        REQUIRE(view.get<int>(1, point_field("x")) == 20);
+        REQUIRE(view.get<double>(0, point_field("y")) == -1.0);
+    }
+
+    std::remove(path.c_str());
+
+    REQUIRE_THROWS(shadow::mapped_file(path));
+}
+
+
+namespace trv_space2
+{
+// same type registered in another manager, in a different order
+REGISTER_TYPE_BEGIN()
+REGISTER_TYPE(trv_named)
+REGISTER_TYPE(trv_point)
+REGISTER_TYPE_END()
+
+REGISTER_MEMBER_VARIABLE(trv_point, y)
+REGISTER_MEMBER_VARIABLE(trv_point, x)
+
+SHADOW_INIT()
+} // namespace trv_space2
+
+
+TEST_CASE("schemas of registered types", "[reflection_manager::type_schema]")
+{
+    const auto& manager = trv_space::manager;
+
+    SECTION("fields in order of offset")
+    {
+        auto schema = manager.type_schema(point_type());
+
+        REQUIRE(std::distance(schema.first, schema.second) == 2);
+        REQUIRE(schema.first[0].name == std::string("x"));
+        REQUIRE(schema.first[0].offset == offsetof(trv_point, x));
+        REQUIRE(schema.first[0].size == sizeof(int));
+        REQUIRE(schema.first[1].name == std::string("y"));
+        REQUIRE(schema.first[1].offset == offsetof(trv_point, y));
+        REQUIRE(schema.first[1].size == sizeof(double));
+    }
+
+    SECTION("hash is the same across managers")
+    {
+        auto other_type = trv_space2::static_construct<trv_point>().type();
+
+        REQUIRE(manager.type_schema_hash(point_type()) ==
+                trv_space2::manager.type_schema_hash(other_type));
+    }
+
+    SECTION("hash differs between types")
+    {
+        auto named = trv_space::static_construct<trv_named>().type();
+
+        REQUIRE(manager.type_schema_hash(point_type()) !=
+                manager.type_schema_hash(named));
+    }
+
+    SECTION("record_view checks the schema hash")
+    {
+        const trv_point points[1] = {{1, 1.5}};
+        const auto hash = manager.type_schema_hash(point_type());
+
+        shadow::record_view view(
+            manager, point_type(), points, sizeof(points), hash);
+        REQUIRE(view.size() == 1);
+
+        REQUIRE_THROWS_AS(
+            shadow::record_view(
+                manager, point_type(), points, sizeof(points), hash + 1),
+            shadow::serialization_error);
+    }
+}
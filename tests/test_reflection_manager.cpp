@@ -51,6 +51,13 @@ TEST_CASE("instantiate reflection_manager with only type_info",
         REQUIRE(types_pair.first->name() == std::string("void"));
         REQUIRE(types_pair.first->size() == 0);
     }
+    SECTION("name views of type_info without stored name length")
+    {
+        auto types_pair = man.types();
+
+        REQUIRE(man.type_name_view(*types_pair.first) == "void");
+        REQUIRE(types_pair.first[1].name_view().size() == 3);
+    }
 }
 
 
@@ -288,3 +295,60 @@ TEST_CASE(
         }
     }
 }
+
+
+TEST_CASE("look up types by name across reflection_managers",
+          "[reflection_manager]")
+{
+    static_assert(shadow::hash_name("int") != shadow::hash_name("long int"),
+                  "hash_name should be usable at compile time");
+
+    const shadow::type_info ti_arr[] = {
+        {"void", 0, nullptr, nullptr},
+        {"int", sizeof(int), nullptr, nullptr},
+        {"double", sizeof(double), nullptr, nullptr},
+        {"long int",
+         sizeof(long int),
+         nullptr,
+         nullptr,
+         shadow::hash_name("long int")}};
+
+    const shadow::constructor_info ci_arr[] = {
+        {2,
+         0,
+         nullptr,
+         nullptr,
+         &shadow::constructor_detail::generic_constructor_bind_point<double>}};
+
+    const shadow::conversion_info* cvi_arr = nullptr;
+    const shadow::free_function_info* ffi_arr = nullptr;
+    const shadow::member_function_info* mfi_arr = nullptr;
+    const shadow::member_variable_info* mvi_arr = nullptr;
+    const shadow::serialization_info* si_arr = nullptr;
+
+    shadow::reflection_manager man(
+        ti_arr, ci_arr, cvi_arr, ffi_arr, mfi_arr, mvi_arr, si_arr);
+
+    SECTION("find constructors with a type_tag from elsewhere")
+    {
+        const shadow::type_info double_info{"double", sizeof(double)};
+
+        auto constructors =
+            man.constructors_by_type(shadow::type_tag(double_info));
+
+        REQUIRE(std::distance(constructors.first, constructors.second) == 1);
+
+        auto no_constructors =
+            man.constructors_by_type(shadow::type_tag(ti_arr[3]));
+
+        REQUIRE(no_constructors.first == no_constructors.second);
+    }
+
+    SECTION("attempt to find constructors of unregistered type")
+    {
+        const shadow::type_info float_info{"float", sizeof(float)};
+
+        CHECK_THROWS_AS(man.constructors_by_type(shadow::type_tag(float_info)),
+                        shadow::type_error);
+    }
+}